@@ -0,0 +1,45 @@
+#include "caller.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+struct Counter
+{
+    void call()
+    {
+        benchmark::DoNotOptimize(++count);
+    }
+    long count = 0;
+};
+
+static void BM_CallerCall(benchmark::State& state)
+{
+    caller::Caller caller;
+    std::vector<std::shared_ptr<Counter>> objects;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        objects.push_back(std::make_shared<Counter>());
+        caller.add(objects.back(), &Counter::call);
+    }
+    for (auto _ : state)
+        caller();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CallerCall)->RangeMultiplier(8)->Range(1, 4096);
+
+static void BM_CallerRemove(benchmark::State& state)
+{
+    std::vector<std::shared_ptr<Counter>> objects;
+    for (int64_t i = 0; i < state.range(0); ++i)
+        objects.push_back(std::make_shared<Counter>());
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        caller::Caller caller;
+        for (const std::shared_ptr<Counter>& object : objects)
+            caller.add(object, &Counter::call);
+        state.ResumeTiming();
+        caller.remove(objects.back(), &Counter::call);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CallerRemove)->RangeMultiplier(8)->Range(1, 4096);
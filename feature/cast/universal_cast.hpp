@@ -1,4 +1,17 @@
+#ifndef UNIVERSAL_CAST_HPP
+#define UNIVERSAL_CAST_HPP
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ratio>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 
 namespace cast
 {
@@ -6,63 +19,742 @@ namespace cast
 namespace detail
 {
 
-namespace relative_time
+template <typename...>
+struct dependent_false : std::false_type
+{
+};
+
+template <typename T>
+struct is_duration : std::false_type
+{
+};
+
+template <typename Rep, typename Period>
+struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type
+{
+};
+
+template <typename T>
+struct is_time_point : std::false_type
+{
+};
+
+template <typename Clock, typename Duration>
+struct is_time_point<std::chrono::time_point<Clock, Duration>> : std::true_type
 {
+};
+
+template <typename T>
+constexpr bool is_number = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+template <typename T>
+constexpr bool is_string = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
 
-// using time_type = boost::variant<>;
+// const char* и строковые литералы приводятся к string_view
+template <typename F>
+constexpr bool is_text = is_string<F> || std::is_convertible_v<const F&, const char*>;
+
+template <typename F>
+std::string_view toView(const F& from)
+{
+    if constexpr (is_string<F>)
+        return std::string_view(from);
+    else
+        return std::string_view(static_cast<const char*>(from));
+}
+
+namespace arithmetic
+{
 
 template <typename T, typename F>
-constexpr bool is_castable()
+constexpr bool is_castable = (std::is_arithmetic_v<T> && std::is_arithmetic_v<F>) ||
+                             (std::is_same_v<T, std::string> && is_number<F>) ||
+                             (is_number<T> && is_text<F>);
+
+template <typename T>
+T parse(std::string_view text)
 {
-    return false; // std::is_constructible_v<time_type, F>;
+    T value{};
+    const char* last = text.data() + text.size();
+    const std::from_chars_result result = std::from_chars(text.data(), last, value);
+    if (result.ec == std::errc::result_out_of_range)
+        throw std::out_of_range("value is out of range: " + std::string(text));
+    if (result.ec != std::errc() || result.ptr != last)
+        throw std::invalid_argument("not a number: " + std::string(text));
+    return value;
+}
+
+template <typename F>
+std::string format(const F& from)
+{
+    char buffer[64];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), from);
+    return std::string(buffer, result.ptr);
 }
 
 template <typename T, typename F>
-T cast(const F& from)
+constexpr T cast(const F& from)
 {
-    static_assert(true, "asd");
+    if constexpr (std::is_same_v<T, std::string>)
+        return format(from);
+    else if constexpr (is_text<F>)
+        return parse<T>(toView(from));
+    else
+        return static_cast<T>(from);
 }
 
-// Специализации
+} // namespace arithmetic
+
+namespace relative_time
+{
+
+template <typename T, typename F>
+constexpr bool is_castable = (is_duration<T>::value && is_duration<F>::value) ||
+                             (is_duration<T>::value && is_number<F>) ||
+                             (is_number<T> && is_duration<F>::value) ||
+                             (std::is_same_v<T, std::string> && is_duration<F>::value) ||
+                             (is_duration<T>::value && is_text<F>);
+
+// суффикс единицы измерения, пустой для нестандартных периодов
+template <typename Period>
+constexpr std::string_view suffix()
+{
+    if constexpr (std::is_same_v<Period, std::nano>)
+        return "ns";
+    else if constexpr (std::is_same_v<Period, std::micro>)
+        return "us";
+    else if constexpr (std::is_same_v<Period, std::milli>)
+        return "ms";
+    else if constexpr (std::is_same_v<Period, std::ratio<1>>)
+        return "s";
+    else if constexpr (std::is_same_v<Period, std::ratio<60>>)
+        return "min";
+    else if constexpr (std::is_same_v<Period, std::ratio<3600>>)
+        return "h";
+    else
+        return "";
+}
+
+template <typename T, typename Rep>
+T fromUnit(Rep count, std::string_view unit)
+{
+    using std::chrono::duration;
+    if (unit == "ns")
+        return std::chrono::duration_cast<T>(duration<Rep, std::nano>(count));
+    if (unit == "us")
+        return std::chrono::duration_cast<T>(duration<Rep, std::micro>(count));
+    if (unit == "ms")
+        return std::chrono::duration_cast<T>(duration<Rep, std::milli>(count));
+    if (unit == "s")
+        return std::chrono::duration_cast<T>(duration<Rep, std::ratio<1>>(count));
+    if (unit == "min")
+        return std::chrono::duration_cast<T>(duration<Rep, std::ratio<60>>(count));
+    if (unit == "h")
+        return std::chrono::duration_cast<T>(duration<Rep, std::ratio<3600>>(count));
+    throw std::invalid_argument("unknown duration unit: " + std::string(unit));
+}
+
+// "150ms" -> duration; без суффикса число трактуется в единицах T
+template <typename T>
+T parse(std::string_view text)
+{
+    using Rep = typename T::rep;
+    const std::size_t digits = text.find_first_not_of("+-.0123456789eE");
+    const std::string_view number = text.substr(0, digits);
+    const std::string_view unit =
+        digits == std::string_view::npos ? std::string_view() : text.substr(digits);
+    const Rep count = arithmetic::parse<Rep>(number);
+    if (unit.empty() || unit == suffix<typename T::period>())
+        return T(count);
+    return fromUnit<T>(count, unit);
+}
+
+template <typename T, typename F>
+constexpr T cast(const F& from)
+{
+    if constexpr (is_duration<T>::value && is_duration<F>::value)
+        return std::chrono::duration_cast<T>(from);
+    else if constexpr (is_duration<T>::value && is_text<F>)
+        return parse<T>(toView(from));
+    else if constexpr (is_duration<T>::value)
+        return T(static_cast<typename T::rep>(from));
+    else if constexpr (std::is_same_v<T, std::string>)
+        return arithmetic::format(from.count()) + std::string(suffix<typename F::period>());
+    else
+        return static_cast<T>(from.count());
+}
 
 } // namespace relative_time
 
 namespace absolute_time
 {
 
-// using time_type = boost::variant<>;
+template <typename T>
+constexpr bool is_system_time = false;
+
+template <typename Duration>
+constexpr bool is_system_time<std::chrono::time_point<std::chrono::system_clock, Duration>> = true;
+
+template <typename T, typename F>
+constexpr bool clocks_match = false;
+
+template <typename Clock, typename D1, typename D2>
+constexpr bool
+    clocks_match<std::chrono::time_point<Clock, D1>, std::chrono::time_point<Clock, D2>> = true;
 
 template <typename T, typename F>
-constexpr bool is_castable()
+constexpr bool is_castable = clocks_match<T, F> ||
+                             (is_time_point<T>::value && is_number<F>) ||
+                             (is_number<T> && is_time_point<F>::value) ||
+                             (std::is_same_v<T, std::string> && is_system_time<F>) ||
+                             (is_system_time<T> && is_text<F>);
+
+// длина "YYYY-MM-DDTHH:MM:SS.fffffffffZ"
+constexpr std::size_t TIMESTAMP_MAX_SIZE = 30;
+
+constexpr std::int64_t SECONDS_PER_DAY = 86400;
+
+// дни от 1970-01-01, алгоритм H. Hinnant "chrono-compatible low-level date algorithms"
+constexpr std::int64_t daysFromCivil(std::int64_t y, unsigned m, unsigned d)
 {
-    return false; // std::is_constructible_v<time_type, F>;
+    y -= m <= 2;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
 }
 
-template <typename T, typename F>
-T cast(const F& from)
+constexpr void civilFromDays(std::int64_t z, std::int64_t& y, unsigned& m, unsigned& d)
+{
+    z += 719468;
+    const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+constexpr unsigned daysInMonth(std::int64_t y, unsigned m)
+{
+    constexpr unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool leap = y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+    return m == 2 && leap ? 29 : days[m - 1];
+}
+
+constexpr std::int64_t floorDiv(std::int64_t a, std::int64_t b)
+{
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+// число знаков дробной части секунды для периода Duration
+template <typename Period>
+constexpr int fractionDigits()
+{
+    if constexpr (Period::num >= Period::den)
+        return 0;
+    else if constexpr (Period::den <= 1000)
+        return 3;
+    else if constexpr (Period::den <= 1000000)
+        return 6;
+    else
+        return 9;
+}
+
+constexpr std::intmax_t pow10(int n)
+{
+    return n == 0 ? 1 : 10 * pow10(n - 1);
+}
+
+/**
+ * Разделить отсчёты на целые секунды (с округлением вниз) и долю секунды в единицах
+ * 10^-Digits
+ * @note Для целочисленных долей секунды считается по отсчётам напрямую: floor<seconds>
+ * у Duration::min() меньше минимума Duration и обратно не преобразуется
+ */
+template <int Digits, typename Duration>
+void splitSeconds(const Duration& since, std::int64_t& whole, std::int64_t& fraction)
+{
+    using namespace std::chrono;
+    using Period = typename Duration::period;
+    if constexpr (Digits > 0 && Period::num == 1 && std::is_integral_v<typename Duration::rep>)
+    {
+        constexpr std::int64_t perSecond = Period::den;
+        const std::int64_t count = since.count();
+        const std::int64_t remainder = count % perSecond;
+        whole = count / perSecond - (remainder < 0);
+        const std::int64_t ticks = remainder < 0 ? remainder + perSecond : remainder;
+        if constexpr (perSecond % pow10(Digits) == 0)
+            fraction = ticks / (perSecond / pow10(Digits));
+        else
+            fraction = ticks * pow10(Digits) / perSecond;
+    }
+    else
+    {
+        const seconds floored = floor<seconds>(since);
+        whole = floored.count();
+        fraction = 0;
+        if constexpr (Digits > 0)
+        {
+            using Fraction = duration<std::int64_t, std::ratio<1, pow10(Digits)>>;
+            fraction = duration_cast<Fraction>(since - floored).count();
+        }
+    }
+}
+
+inline void write2(char* p, unsigned value)
+{
+    static const char pairs[] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    std::memcpy(p, pairs + 2 * value, 2);
+}
+
+inline bool isDigit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+inline unsigned read2(const char* p)
 {
-    static_assert(true, "asd");
+    return static_cast<unsigned>(p[0] - '0') * 10 + static_cast<unsigned>(p[1] - '0');
 }
 
-// Специализации
+// последняя отформатированная или разобранная дата одного потока
+struct DateCache
+{
+    bool valid = false;
+    std::int64_t days = 0;
+    char text[10] = {};
+};
+
+inline DateCache& formatCache()
+{
+    static thread_local DateCache cache;
+    return cache;
+}
+
+inline DateCache& parseCache()
+{
+    static thread_local DateCache cache;
+    return cache;
+}
+
+/**
+ * Разобрать "HH:MM:SS" одним 8-байтовым словом (SWAR)
+ * @return false, если формат нарушен
+ */
+inline bool parseTime(const char* p, unsigned& h, unsigned& m, unsigned& s)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    // байты 0,1,3,4,6,7 - цифры, байты 2 и 5 - двоеточия
+    const std::uint64_t digits = 0xFFFF00FFFF00FFFFull;
+    const std::uint64_t colons = 0x0000FF0000FF0000ull;
+    if ((word & colons) != (0x3A3A3A3A3A3A3A3Aull & colons))
+        return false;
+    if ((word & 0xF0F0F0F0F0F0F0F0ull & digits) != (0x3030303030303030ull & digits))
+        return false;
+    if (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull & digits) !=
+        (0x3030303030303030ull & digits))
+        return false;
+    // пары цифр: десятки в младшем байте, единицы - в следующем
+    // байт не превышает 99, поэтому переносов между байтами нет
+    std::uint64_t value = word & 0x0F0F0F0F0F0F0F0Full & digits;
+    value = value * 10 + (value >> 8);
+    h = static_cast<unsigned>(value & 0xFF);
+    m = static_cast<unsigned>((value >> 24) & 0xFF);
+    s = static_cast<unsigned>((value >> 48) & 0xFF);
+    return true;
+#else
+    if (!isDigit(p[0]) || !isDigit(p[1]) || p[2] != ':' || !isDigit(p[3]) || !isDigit(p[4]) ||
+        p[5] != ':' || !isDigit(p[6]) || !isDigit(p[7]))
+        return false;
+    h = read2(p);
+    m = read2(p + 3);
+    s = read2(p + 6);
+    return true;
+#endif
+}
+
+// "YYYY-MM-DD" -> дни от эпохи
+inline bool parseDate(const char* p, std::int64_t& days)
+{
+    DateCache& cache = parseCache();
+    if (cache.valid && std::memcmp(p, cache.text, sizeof(cache.text)) == 0)
+    {
+        days = cache.days;
+        return true;
+    }
+    for (int i : {0, 1, 2, 3, 5, 6, 8, 9})
+    {
+        if (!isDigit(p[i]))
+            return false;
+    }
+    if (p[4] != '-' || p[7] != '-')
+        return false;
+    const std::int64_t y = read2(p) * 100 + read2(p + 2);
+    const unsigned m = read2(p + 5);
+    const unsigned d = read2(p + 8);
+    if (m < 1 || m > 12 || d < 1 || d > daysInMonth(y, m))
+        return false;
+    days = daysFromCivil(y, m, d);
+    std::memcpy(cache.text, p, sizeof(cache.text));
+    cache.days = days;
+    cache.valid = true;
+    return true;
+}
+
+/**
+ * Записать time_point в формате RFC 3339 (UTC, суффикс Z)
+ * @note Число знаков дробной части определяется точностью Duration
+ */
+template <typename Duration>
+std::to_chars_result
+format(char* first, char* last,
+       const std::chrono::time_point<std::chrono::system_clock, Duration>& from)
+{
+    using namespace std::chrono;
+    constexpr int digits = fractionDigits<typename Duration::period>();
+    constexpr std::ptrdiff_t size = 20 + (digits ? digits + 1 : 0);
+    if (last - first < size)
+        return {last, std::errc::value_too_large};
+
+    std::int64_t total;
+    std::int64_t fraction;
+    splitSeconds<digits>(from.time_since_epoch(), total, fraction);
+    const std::int64_t days = floorDiv(total, SECONDS_PER_DAY);
+    const std::int64_t daySeconds = total - days * SECONDS_PER_DAY;
+
+    DateCache& cache = formatCache();
+    if (!cache.valid || cache.days != days)
+    {
+        std::int64_t y;
+        unsigned m, d;
+        civilFromDays(days, y, m, d);
+        if (y < 0 || y > 9999)
+            return {last, std::errc::value_too_large};
+        write2(cache.text, static_cast<unsigned>(y / 100));
+        write2(cache.text + 2, static_cast<unsigned>(y % 100));
+        cache.text[4] = '-';
+        write2(cache.text + 5, m);
+        cache.text[7] = '-';
+        write2(cache.text + 8, d);
+        cache.days = days;
+        cache.valid = true;
+    }
+    std::memcpy(first, cache.text, sizeof(cache.text));
+    first[10] = 'T';
+    write2(first + 11, static_cast<unsigned>(daySeconds / 3600));
+    first[13] = ':';
+    write2(first + 14, static_cast<unsigned>(daySeconds / 60 % 60));
+    first[16] = ':';
+    write2(first + 17, static_cast<unsigned>(daySeconds % 60));
+    char* p = first + 19;
+    if constexpr (digits > 0)
+    {
+        *p++ = '.';
+        for (int i = digits - 1; i >= 0; --i)
+        {
+            p[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        p += digits;
+    }
+    *p++ = 'Z';
+    return {p, std::errc()};
+}
+
+/**
+ * Разобрать метку времени RFC 3339: YYYY-MM-DD(T|t| )HH:MM:SS[.f+](Z|z|+HH:MM|-HH:MM)
+ * @note Знаки дробной части сверх наносекунд отбрасываются
+ */
+template <typename Duration>
+std::from_chars_result parse(const char* first, const char* last,
+                             std::chrono::time_point<std::chrono::system_clock, Duration>& to)
+{
+    using namespace std::chrono;
+    const std::from_chars_result invalid{first, std::errc::invalid_argument};
+    if (last - first < 20)
+        return invalid;
+    std::int64_t days;
+    if (!parseDate(first, days))
+        return invalid;
+    if (first[10] != 'T' && first[10] != 't' && first[10] != ' ')
+        return invalid;
+    unsigned h, m, s;
+    if (!parseTime(first + 11, h, m, s) || h > 23 || m > 59 || s > 60)
+        return invalid;
+
+    const char* p = first + 19;
+    std::int64_t nanos = 0;
+    if (*p == '.')
+    {
+        ++p;
+        int digits = 0;
+        for (; p != last && isDigit(*p); ++p, ++digits)
+        {
+            if (digits < 9)
+                nanos = nanos * 10 + (*p - '0');
+        }
+        if (digits == 0)
+            return invalid;
+        for (; digits < 9; ++digits)
+            nanos *= 10;
+    }
+
+    std::int64_t offset = 0;
+    if (p != last && (*p == 'Z' || *p == 'z'))
+    {
+        ++p;
+    }
+    else if (last - p >= 6 && (*p == '+' || *p == '-') && isDigit(p[1]) && isDigit(p[2]) &&
+             p[3] == ':' && isDigit(p[4]) && isDigit(p[5]))
+    {
+        const unsigned oh = read2(p + 1);
+        const unsigned om = read2(p + 4);
+        if (oh > 23 || om > 59)
+            return invalid;
+        offset = (*p == '-' ? -1 : 1) * static_cast<std::int64_t>(oh * 3600 + om * 60);
+        p += 6;
+    }
+    else
+    {
+        return invalid;
+    }
+
+    const seconds total(days * SECONDS_PER_DAY + h * 3600 + m * 60 + s - offset);
+    const Duration fraction = duration_cast<Duration>(nanoseconds(nanos));
+    // граница проверяется вместе с дробной частью: целые секунды на краю диапазона
+    // ещё представимы, а их сумма с дробью - уже нет
+    const seconds upper = floor<seconds>(Duration::max() - fraction);
+    const seconds lower = ceil<seconds>(Duration::min());
+    if (total > upper)
+        return {p, std::errc::result_out_of_range};
+    if (total < lower)
+    {
+        // ненулевая дробь означает период меньше секунды, и lower - 1с не переполняется
+        if (fraction == Duration::zero() || total < lower - seconds(1))
+            return {p, std::errc::result_out_of_range};
+        // total + fraction = lower + (fraction - 1с), оба слагаемых представимы в Duration
+        const Duration below = fraction - duration_cast<Duration>(seconds(1));
+        if (below < Duration::min() - duration_cast<Duration>(lower))
+            return {p, std::errc::result_out_of_range};
+        to = time_point<system_clock, Duration>(duration_cast<Duration>(lower) + below);
+        return {p, std::errc()};
+    }
+    to = time_point<system_clock, Duration>(duration_cast<Duration>(total) + fraction);
+    return {p, std::errc()};
+}
+
+// число - отсчёты от эпохи часов в единицах time_point, строка - RFC 3339
+template <typename T, typename F>
+constexpr T cast(const F& from)
+{
+    if constexpr (clocks_match<T, F>)
+    {
+        return std::chrono::time_point_cast<typename T::duration>(from);
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        char buffer[TIMESTAMP_MAX_SIZE];
+        const std::to_chars_result result = format(buffer, buffer + sizeof(buffer), from);
+        if (result.ec != std::errc())
+            throw std::out_of_range("time point is out of timestamp range");
+        return std::string(buffer, result.ptr);
+    }
+    else if constexpr (is_text<F>)
+    {
+        const std::string_view text = toView(from);
+        T to{};
+        const std::from_chars_result result = parse(text.data(), text.data() + text.size(), to);
+        if (result.ec == std::errc::result_out_of_range)
+            throw std::out_of_range("timestamp is out of range: " + std::string(text));
+        if (result.ec != std::errc() || result.ptr != text.data() + text.size())
+            throw std::invalid_argument("not a timestamp: " + std::string(text));
+        return to;
+    }
+    else if constexpr (is_time_point<T>::value)
+    {
+        return T(typename T::duration(static_cast<typename T::rep>(from)));
+    }
+    else
+    {
+        return static_cast<T>(from.time_since_epoch().count());
+    }
+}
 
 } // namespace absolute_time
 
 } // namespace detail
 
+/**
+ * Есть ли преобразование F -> T
+ */
 template <typename T, typename F>
-T universal_cast(const F& from)
+constexpr bool is_castable_v =
+    std::is_same_v<T, F> || detail::arithmetic::is_castable<T, F> ||
+    detail::relative_time::is_castable<T, F> || detail::absolute_time::is_castable<T, F> ||
+    std::is_constructible_v<T, const F&>;
+
+/**
+ * Универсальное преобразование, выбор способа выполняется на этапе компиляции
+ * @throw std::invalid_argument, std::out_of_range при разборе строки
+ */
+template <typename T, typename F>
+constexpr T universal_cast(const F& from)
 {
-    if constexpr (std::is_arithmetic_v<T> && std::is_arithmetic_v<F>)
-        return static_cast<T>(from);
-    else if constexpr (std::is_constructible_v<T, F>)
-        return T(from);
+    if constexpr (std::is_same_v<T, F>)
+        return from;
+    else if constexpr (detail::arithmetic::is_castable<T, F>)
+        return detail::arithmetic::cast<T, F>(from);
     else if constexpr (detail::relative_time::is_castable<T, F>)
         return detail::relative_time::cast<T, F>(from);
     else if constexpr (detail::absolute_time::is_castable<T, F>)
         return detail::absolute_time::cast<T, F>(from);
+    else if constexpr (std::is_constructible_v<T, const F&>)
+        return T(from);
+    else
+        static_assert(detail::dependent_false<T, F>::value, "No conversion available");
+}
+
+/**
+ * Записать метку времени RFC 3339 в буфер без выделения памяти
+ * @return как у std::to_chars, value_too_large - буфер мал или год вне 0000-9999
+ */
+template <typename Duration>
+std::to_chars_result
+formatTimestamp(char* first, char* last,
+                const std::chrono::time_point<std::chrono::system_clock, Duration>& from)
+{
+    return detail::absolute_time::format(first, last, from);
+}
+
+/**
+ * Разобрать метку времени RFC 3339 без выделения памяти
+ * @return как у std::from_chars, ptr указывает на первый неразобранный символ
+ */
+template <typename Duration>
+std::from_chars_result
+parseTimestamp(const char* first, const char* last,
+               std::chrono::time_point<std::chrono::system_clock, Duration>& to)
+{
+    return detail::absolute_time::parse(first, last, to);
+}
+
+namespace detail
+{
+
+template <typename T, typename F>
+constexpr bool inRange(F value)
+{
+    using T_limits = std::numeric_limits<T>;
+    if constexpr (std::is_signed_v<F> == std::is_signed_v<T>)
+        return value >= T_limits::min() && value <= T_limits::max();
+    else if constexpr (std::is_signed_v<F>)
+        return value >= 0 && static_cast<std::make_unsigned_t<F>>(value) <= T_limits::max();
     else
-        static_assert(true, "No conversion available");
+        return value <= static_cast<std::make_unsigned_t<T>>(T_limits::max());
+}
+
+// диапазон [min, max + 1) целого T, проверка отбрасывает и NaN
+template <typename T>
+constexpr bool inRange(long double value)
+{
+    const long double low = static_cast<long double>(std::numeric_limits<T>::min());
+    const long double high = static_cast<long double>(std::numeric_limits<T>::max()) + 1.0L;
+    return value >= low && value < high;
+}
+
+} // namespace detail
+
+/**
+ * Преобразование с проверкой сужения без исключений
+ * @return std::errc() при успехе, result_out_of_range при переполнении,
+ * invalid_argument при ошибке разбора строки; при ошибке to не меняется
+ */
+template <typename T, typename F>
+std::errc checked_cast(const F& from, T& to) noexcept
+{
+    if constexpr (std::is_integral_v<T> && std::is_integral_v<F>)
+    {
+        if (!detail::inRange<T>(from))
+            return std::errc::result_out_of_range;
+        to = static_cast<T>(from);
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_floating_point_v<F>)
+    {
+        if (!detail::inRange<T>(static_cast<long double>(from)))
+            return std::errc::result_out_of_range;
+        to = static_cast<T>(from);
+    }
+    else if constexpr (std::is_floating_point_v<T> && std::is_arithmetic_v<F>)
+    {
+        const long double value = static_cast<long double>(from);
+        const long double max = static_cast<long double>(std::numeric_limits<T>::max());
+        if (value > max || value < -max)
+            return std::errc::result_out_of_range;
+        to = static_cast<T>(from);
+    }
+    else if constexpr (detail::is_duration<T>::value && detail::is_duration<F>::value)
+    {
+        using Ratio = std::ratio_divide<typename F::period, typename T::period>;
+        const long double value = static_cast<long double>(from.count()) *
+                                  static_cast<long double>(Ratio::num) /
+                                  static_cast<long double>(Ratio::den);
+        if constexpr (std::is_integral_v<typename T::rep>)
+        {
+            if (!detail::inRange<typename T::rep>(value))
+                return std::errc::result_out_of_range;
+        }
+        to = std::chrono::duration_cast<T>(from);
+    }
+    else if constexpr (detail::absolute_time::clocks_match<T, F>)
+    {
+        typename T::duration since{};
+        const std::errc ec = checked_cast(from.time_since_epoch(), since);
+        if (ec != std::errc())
+            return ec;
+        to = T(since);
+    }
+    else if constexpr (detail::is_number<T> && detail::is_text<F>)
+    {
+        const std::string_view text = detail::toView(from);
+        T value{};
+        const char* last = text.data() + text.size();
+        const std::from_chars_result result = std::from_chars(text.data(), last, value);
+        if (result.ec != std::errc())
+            return result.ec;
+        if (result.ptr != last)
+            return std::errc::invalid_argument;
+        to = value;
+    }
+    else if constexpr (detail::absolute_time::is_system_time<T> && detail::is_text<F>)
+    {
+        const std::string_view text = detail::toView(from);
+        T value{};
+        const char* last = text.data() + text.size();
+        const std::from_chars_result result = parseTimestamp(text.data(), last, value);
+        if (result.ec != std::errc())
+            return result.ec;
+        if (result.ptr != last)
+            return std::errc::invalid_argument;
+        to = value;
+    }
+    else
+    {
+        static_assert(detail::dependent_false<T, F>::value, "No checked conversion available");
+    }
+    return std::errc();
 }
 
 } // namespace cast
+
+#endif // UNIVERSAL_CAST_HPP
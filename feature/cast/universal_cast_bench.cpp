@@ -0,0 +1,157 @@
+#include "universal_cast.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+static std::vector<double> values()
+{
+    std::vector<double> result(1024);
+    for (std::size_t i = 0; i < result.size(); ++i)
+        result[i] = static_cast<double>(i) * 1.25;
+    return result;
+}
+
+static void BM_StaticCast(benchmark::State& state)
+{
+    const std::vector<double> input = values();
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (double value : input)
+            sum += static_cast<long>(value);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_StaticCast);
+
+static void BM_UniversalCastArithmetic(benchmark::State& state)
+{
+    const std::vector<double> input = values();
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (double value : input)
+            sum += cast::universal_cast<long>(value);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_UniversalCastArithmetic);
+
+static void BM_DurationCast(benchmark::State& state)
+{
+    const std::vector<double> input = values();
+    for (auto _ : state)
+    {
+        milliseconds sum{};
+        for (double value : input)
+            sum += duration_cast<milliseconds>(duration<double>(value));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_DurationCast);
+
+static void BM_UniversalCastDuration(benchmark::State& state)
+{
+    const std::vector<double> input = values();
+    for (auto _ : state)
+    {
+        milliseconds sum{};
+        for (double value : input)
+            sum += cast::universal_cast<milliseconds>(duration<double>(value));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_UniversalCastDuration);
+
+static std::vector<system_clock::time_point> timestamps()
+{
+    std::vector<system_clock::time_point> result(1024);
+    for (std::size_t i = 0; i < result.size(); ++i)
+        result[i] = system_clock::time_point(seconds(1700000000 + i * 3607));
+    return result;
+}
+
+static void BM_FormatTimestampStrftime(benchmark::State& state)
+{
+    const std::vector<system_clock::time_point> input = timestamps();
+    char buffer[32];
+    for (auto _ : state)
+    {
+        for (const system_clock::time_point& point : input)
+        {
+            const std::time_t time = system_clock::to_time_t(point);
+            std::tm tm{};
+            gmtime_r(&time, &tm);
+            benchmark::DoNotOptimize(std::strftime(buffer, sizeof(buffer), "%FT%TZ", &tm));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_FormatTimestampStrftime);
+
+static void BM_FormatTimestamp(benchmark::State& state)
+{
+    const std::vector<system_clock::time_point> input = timestamps();
+    char buffer[32];
+    for (auto _ : state)
+    {
+        for (const system_clock::time_point& point : input)
+        {
+            const time_point<system_clock, seconds> s = time_point_cast<seconds>(point);
+            benchmark::DoNotOptimize(cast::formatTimestamp(buffer, buffer + sizeof(buffer), s));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_FormatTimestamp);
+
+static std::vector<std::string> timestampTexts()
+{
+    std::vector<std::string> result;
+    for (const system_clock::time_point& point : timestamps())
+        result.push_back(cast::universal_cast<std::string>(time_point_cast<seconds>(point)));
+    return result;
+}
+
+static void BM_ParseTimestampSscanf(benchmark::State& state)
+{
+    const std::vector<std::string> input = timestampTexts();
+    for (auto _ : state)
+    {
+        for (const std::string& text : input)
+        {
+            std::tm tm{};
+            std::sscanf(text.c_str(), "%d-%d-%dT%d:%d:%dZ", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+                        &tm.tm_hour, &tm.tm_min, &tm.tm_sec);
+            tm.tm_year -= 1900;
+            tm.tm_mon -= 1;
+            benchmark::DoNotOptimize(timegm(&tm));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_ParseTimestampSscanf);
+
+static void BM_ParseTimestamp(benchmark::State& state)
+{
+    const std::vector<std::string> input = timestampTexts();
+    for (auto _ : state)
+    {
+        for (const std::string& text : input)
+        {
+            time_point<system_clock, seconds> point;
+            cast::parseTimestamp(text.data(), text.data() + text.size(), point);
+            benchmark::DoNotOptimize(point);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_ParseTimestamp);
@@ -1,7 +1,222 @@
 #include "universal_cast.hpp"
+#include <cmath>
 #include <gtest/gtest.h>
+#include <thread>
 
-TEST(CastTest, test)
+using namespace std::chrono;
+using cast::universal_cast;
+
+TEST(CastTest, Arithmetic)
+{
+    static_assert(universal_cast<int>(3.7) == 3, "compile time arithmetic cast");
+    EXPECT_EQ(3, universal_cast<int>(3.7));
+    EXPECT_DOUBLE_EQ(2.0, universal_cast<double>(2));
+    EXPECT_EQ('A', universal_cast<char>(65));
+}
+
+TEST(CastTest, String)
+{
+    EXPECT_EQ("42", universal_cast<std::string>(42));
+    EXPECT_EQ("-1.5", universal_cast<std::string>(-1.5));
+    EXPECT_EQ(42, universal_cast<int>("42"));
+    EXPECT_EQ(42, universal_cast<int>(std::string("42")));
+    EXPECT_DOUBLE_EQ(0.25, universal_cast<double>(std::string_view("0.25")));
+    EXPECT_THROW(universal_cast<int>("4x2"), std::invalid_argument);
+    EXPECT_THROW(universal_cast<int>(""), std::invalid_argument);
+    EXPECT_THROW(universal_cast<signed char>("300"), std::out_of_range);
+    EXPECT_EQ("text", universal_cast<std::string>("text"));
+}
+
+TEST(CastTest, Duration)
 {
-    EXPECT_TRUE(true);
+    static_assert(universal_cast<seconds>(milliseconds(1500)) == seconds(1), "duration cast");
+    static_assert(universal_cast<milliseconds>(2) == milliseconds(2), "count to duration");
+    static_assert(universal_cast<long>(minutes(3)) == 3, "duration to count");
+    EXPECT_EQ(milliseconds(1500), universal_cast<milliseconds>(duration<double>(1.5)));
+    EXPECT_DOUBLE_EQ(1.5, universal_cast<duration<double>>(milliseconds(1500)).count());
+}
+
+TEST(CastTest, DurationString)
+{
+    EXPECT_EQ("150ms", universal_cast<std::string>(milliseconds(150)));
+    EXPECT_EQ("2h", universal_cast<std::string>(hours(2)));
+    EXPECT_EQ(milliseconds(150), universal_cast<milliseconds>("150ms"));
+    EXPECT_EQ(milliseconds(2000), universal_cast<milliseconds>("2s"));
+    EXPECT_EQ(seconds(120), universal_cast<seconds>("2min"));
+    EXPECT_EQ(seconds(7), universal_cast<seconds>("7"));
+    EXPECT_THROW(universal_cast<seconds>("7 days"), std::invalid_argument);
+}
+
+TEST(CastTest, TimePoint)
+{
+    using Point = time_point<system_clock, seconds>;
+    const Point point(seconds(1700000000));
+    EXPECT_EQ(point, universal_cast<Point>(1700000000));
+    EXPECT_EQ(1700000000, universal_cast<long long>(point));
+    const auto fine = universal_cast<time_point<system_clock, milliseconds>>(point);
+    EXPECT_EQ(1700000000000, fine.time_since_epoch().count());
+    EXPECT_EQ(point, universal_cast<Point>(fine + milliseconds(999)));
+}
+
+TEST(CastTest, Castable)
+{
+    static_assert(cast::is_castable_v<int, double>, "");
+    static_assert(cast::is_castable_v<seconds, milliseconds>, "");
+    static_assert(cast::is_castable_v<std::string, const char*>, "");
+    static_assert(!cast::is_castable_v<seconds, std::vector<int>>, "");
+    static_assert(!cast::is_castable_v<time_point<steady_clock>, time_point<system_clock>>, "");
+    static_assert(!cast::is_castable_v<int, void*>, "");
+    EXPECT_TRUE((cast::is_castable_v<time_point<system_clock>, long long>));
+}
+
+using SystemSeconds = time_point<system_clock, seconds>;
+using SystemMillis = time_point<system_clock, milliseconds>;
+using SystemNanos = time_point<system_clock, nanoseconds>;
+
+TEST(CastTest, FormatTimestamp)
+{
+    char buffer[32];
+    const SystemSeconds point(seconds(1700000000));
+    std::to_chars_result result = cast::formatTimestamp(buffer, buffer + sizeof(buffer), point);
+    ASSERT_EQ(std::errc(), result.ec);
+    EXPECT_EQ("2023-11-14T22:13:20Z", std::string(buffer, result.ptr));
+
+    const SystemMillis millis(milliseconds(1700000000007));
+    result = cast::formatTimestamp(buffer, buffer + sizeof(buffer), millis);
+    EXPECT_EQ("2023-11-14T22:13:20.007Z", std::string(buffer, result.ptr));
+
+    const SystemNanos before(nanoseconds(-1));
+    result = cast::formatTimestamp(buffer, buffer + sizeof(buffer), before);
+    EXPECT_EQ("1969-12-31T23:59:59.999999999Z", std::string(buffer, result.ptr));
+
+    result = cast::formatTimestamp(buffer, buffer + 10, point);
+    EXPECT_EQ(std::errc::value_too_large, result.ec);
+}
+
+TEST(CastTest, FormatTimestampDateCache)
+{
+    char buffer[32];
+    for (int day = 0; day < 3; ++day)
+    {
+        for (int second : {0, 86399})
+        {
+            const SystemSeconds point(seconds(day * 86400 + second));
+            std::to_chars_result result =
+                cast::formatTimestamp(buffer, buffer + sizeof(buffer), point);
+            const std::string expected = "1970-01-0" + std::to_string(day + 1) +
+                                         (second ? "T23:59:59Z" : "T00:00:00Z");
+            EXPECT_EQ(expected, std::string(buffer, result.ptr));
+        }
+    }
+}
+
+TEST(CastTest, ParseTimestamp)
+{
+    const std::string text = "2023-11-14T22:13:20.123456789Z";
+    SystemNanos point;
+    std::from_chars_result result =
+        cast::parseTimestamp(text.data(), text.data() + text.size(), point);
+    ASSERT_EQ(std::errc(), result.ec);
+    EXPECT_EQ(text.data() + text.size(), result.ptr);
+    EXPECT_EQ(1700000000123456789, point.time_since_epoch().count());
+
+    EXPECT_EQ(SystemSeconds(seconds(1700000000)),
+              universal_cast<SystemSeconds>("2023-11-15 01:13:20+03:00"));
+    EXPECT_EQ(SystemSeconds(seconds(1700000000)),
+              universal_cast<SystemSeconds>("2023-11-14t17:13:20-05:00"));
+    EXPECT_EQ(SystemMillis(milliseconds(1700000000500)),
+              universal_cast<SystemMillis>("2023-11-14T22:13:20.5Z"));
+    EXPECT_EQ(SystemSeconds(seconds(951782400)),
+              universal_cast<SystemSeconds>("2000-02-29T00:00:00Z"));
+}
+
+TEST(CastTest, ParseTimestampInvalid)
+{
+    for (const char* text :
+         {"2023-11-14T22:13:20", "2023-11-14T22:13Z", "2023-13-14T22:13:20Z",
+          "2023-02-29T22:13:20Z", "2023-11-14T24:13:20Z", "2023-11-14T22:13:20.Z",
+          "2023-11-14T22:1a:20Z", "2023/11/14T22:13:20Z", "2023-11-14T22:13:20+3:00"})
+    {
+        EXPECT_THROW(universal_cast<SystemSeconds>(text), std::invalid_argument) << text;
+    }
+    EXPECT_THROW(universal_cast<SystemNanos>("9999-01-01T00:00:00Z"), std::out_of_range);
+}
+
+TEST(CastTest, ParseTimestampNulDateWithEmptyCache)
+{
+    // кэш даты нового потока пуст и не должен совпадать с нулевыми байтами
+    std::thread([]
+                {
+                    const std::string text = std::string(10, '\0') + "T00:00:00Z";
+                    SystemSeconds point;
+                    std::from_chars_result result =
+                        cast::parseTimestamp(text.data(), text.data() + text.size(), point);
+                    EXPECT_EQ(std::errc::invalid_argument, result.ec);
+                })
+        .join();
+}
+
+TEST(CastTest, FormatTimestampRangeWithFraction)
+{
+    EXPECT_EQ("1677-09-21T00:12:43.145224192Z", universal_cast<std::string>(SystemNanos::min()));
+    EXPECT_EQ("2262-04-11T23:47:16.854775807Z", universal_cast<std::string>(SystemNanos::max()));
+    EXPECT_EQ("1969-12-31T23:59:59.999999999Z",
+              universal_cast<std::string>(SystemNanos(nanoseconds(-1))));
+    EXPECT_EQ("1969-12-31T23:59:59.999Z",
+              universal_cast<std::string>(SystemMillis(milliseconds(-1))));
+    const system_clock::time_point lowest = system_clock::time_point::min();
+    EXPECT_EQ(lowest, universal_cast<system_clock::time_point>(
+                          universal_cast<std::string>(lowest)));
+}
+
+TEST(CastTest, ParseTimestampRangeWithFraction)
+{
+    EXPECT_EQ(SystemNanos::max(), universal_cast<SystemNanos>("2262-04-11T23:47:16.854775807Z"));
+    EXPECT_THROW(universal_cast<SystemNanos>("2262-04-11T23:47:16.854775808Z"),
+                 std::out_of_range);
+    EXPECT_EQ(SystemNanos::min(), universal_cast<SystemNanos>("1677-09-21T00:12:43.145224192Z"));
+    EXPECT_THROW(universal_cast<SystemNanos>("1677-09-21T00:12:43.145224191Z"),
+                 std::out_of_range);
+    EXPECT_THROW(universal_cast<SystemNanos>("1677-09-21T00:12:42Z"), std::out_of_range);
+}
+
+TEST(CastTest, TimestampRoundTrip)
+{
+    const SystemMillis point(milliseconds(1234567890123));
+    EXPECT_EQ("2009-02-13T23:31:30.123Z", universal_cast<std::string>(point));
+    EXPECT_EQ(point, universal_cast<SystemMillis>(universal_cast<std::string>(point)));
+}
+
+TEST(CastTest, CheckedCast)
+{
+    signed char small = 0;
+    EXPECT_EQ(std::errc(), cast::checked_cast(100, small));
+    EXPECT_EQ(100, small);
+    EXPECT_EQ(std::errc::result_out_of_range, cast::checked_cast(200, small));
+
+    unsigned value = 7;
+    EXPECT_EQ(std::errc::result_out_of_range, cast::checked_cast(-1, value));
+    EXPECT_EQ(7u, value);
+    EXPECT_EQ(std::errc::result_out_of_range, cast::checked_cast(1e10, value));
+    EXPECT_EQ(std::errc::result_out_of_range, cast::checked_cast(std::nan(""), value));
+    EXPECT_EQ(std::errc(), cast::checked_cast(4e9, value));
+
+    float f = 0;
+    EXPECT_EQ(std::errc::result_out_of_range, cast::checked_cast(1e300, f));
+
+    nanoseconds ns{};
+    EXPECT_EQ(std::errc::result_out_of_range, cast::checked_cast(hours(10000000), ns));
+    EXPECT_EQ(std::errc(), cast::checked_cast(hours(1000), ns));
+    EXPECT_EQ(hours(1000), ns);
+
+    int parsed = 0;
+    EXPECT_EQ(std::errc::invalid_argument, cast::checked_cast("12a", parsed));
+    EXPECT_EQ(std::errc::result_out_of_range, cast::checked_cast("99999999999", parsed));
+    EXPECT_EQ(std::errc(), cast::checked_cast("-12", parsed));
+    EXPECT_EQ(-12, parsed);
+
+    SystemSeconds point;
+    EXPECT_EQ(std::errc::invalid_argument, cast::checked_cast("yesterday", point));
+    EXPECT_EQ(std::errc(), cast::checked_cast("1970-01-02T00:00:00Z", point));
+    EXPECT_EQ(86400, point.time_since_epoch().count());
 }
@@ -1,24 +1,137 @@
+#ifndef BUILDER_HPP
+#define BUILDER_HPP
+
+#include "flat_map.hpp"
+#include <array>
+#include <cstddef>
+#include <functional>
 #include <list>
+#include <map>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace collection
 {
 
-template <typename Item, typename Collection, void (Collection::*Appender)(const Item&)>
+namespace detail
+{
+
+// добавление в конец последовательного контейнера
+struct BackAppender
+{
+    template <typename Collection, typename... Args>
+    static void append(Collection& collection, Args&&... args)
+    {
+        collection.emplace_back(std::forward<Args>(args)...);
+    }
+    template <typename Collection>
+    static void finish(Collection&)
+    {
+    }
+};
+
+// вставка в ассоциативный контейнер
+struct Inserter
+{
+    template <typename Collection, typename... Args>
+    static void append(Collection& collection, Args&&... args)
+    {
+        collection.emplace(std::forward<Args>(args)...);
+    }
+    template <typename Collection>
+    static void finish(Collection&)
+    {
+    }
+};
+
+} // namespace detail
+
+/**
+ * Построитель коллекции цепочкой вызовов: Builder(1)(2)(3)
+ * Appender задаёт добавление элемента (append) и завершение сборки (finish)
+ * @note Временный построитель передаёт элементы и коллекцию перемещением
+ */
+template <typename Item, typename Collection, typename Appender = detail::BackAppender>
 class CollectionBuilder
 {
 public:
+    CollectionBuilder() = default;
+    /**
+     * Начать сборку упорядоченной коллекции с заданным экземпляром компаратора
+     */
+    template <typename C = Collection>
+    explicit CollectionBuilder(const typename C::key_compare& compare) : collection(compare)
+    {
+    }
     CollectionBuilder(const Item& item)
     {
-        (collection.*Appender)(item);
+        Appender::append(collection, item);
+    };
+    CollectionBuilder(Item&& item)
+    {
+        Appender::append(collection, std::move(item));
+    };
+    CollectionBuilder& operator()(const Item& item) &
+    {
+        Appender::append(collection, item);
+        return *this;
+    };
+    CollectionBuilder&& operator()(const Item& item) &&
+    {
+        Appender::append(collection, item);
+        return std::move(*this);
     };
-    CollectionBuilder& operator()(const Item& item)
+    CollectionBuilder& operator()(Item&& item) &
     {
-        (collection.*Appender)(item);
+        Appender::append(collection, std::move(item));
         return *this;
     };
-    operator Collection() const
+    CollectionBuilder&& operator()(Item&& item) &&
+    {
+        Appender::append(collection, std::move(item));
+        return std::move(*this);
+    };
+    /**
+     * Создать элемент на месте из аргументов конструктора
+     */
+    template <typename... Args>
+    CollectionBuilder& emplace(Args&&... args) &
+    {
+        Appender::append(collection, std::forward<Args>(args)...);
+        return *this;
+    }
+    template <typename... Args>
+    CollectionBuilder&& emplace(Args&&... args) &&
+    {
+        Appender::append(collection, std::forward<Args>(args)...);
+        return std::move(*this);
+    }
+    /**
+     * Зарезервировать память, если коллекция это поддерживает
+     */
+    template <typename C = Collection>
+    auto reserve(std::size_t size) & -> decltype(std::declval<C&>().reserve(size), *this)
     {
+        collection.reserve(size);
+        return *this;
+    }
+    template <typename C = Collection>
+    auto reserve(std::size_t size) && -> decltype(std::declval<C&>().reserve(size),
+                                                  std::move(*this))
+    {
+        collection.reserve(size);
+        return std::move(*this);
+    }
+    operator Collection() const&
+    {
+        Collection result(collection);
+        Appender::finish(result);
+        return result;
+    }
+    operator Collection() &&
+    {
+        Appender::finish(collection);
         return std::move(collection);
     }
 private:
@@ -26,12 +139,68 @@ private:
 };
 
 template <typename Item>
-using VectorBuilder = CollectionBuilder<Item, std::vector<Item>, &std::vector<Item>::push_back>;
+using VectorBuilder = CollectionBuilder<Item, std::vector<Item>>;
 
 template <typename Item>
-using ListBuilder = CollectionBuilder<Item, std::list<Item>, &std::list<Item>::push_back>;
+using ListBuilder = CollectionBuilder<Item, std::list<Item>>;
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using MapBuilder = CollectionBuilder<std::pair<Key, Value>, std::map<Key, Value, Compare>,
+                                     detail::Inserter>;
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using FlatMapBuilder = CollectionBuilder<std::pair<Key, Value>, FlatMap<Key, Value, Compare>,
+                                         detail::FlatAppender>;
+
+/**
+ * Построитель std::array без выделения памяти
+ * @note Годится для constexpr, недостающие элементы остаются созданными по умолчанию
+ */
+template <typename Item, std::size_t N>
+class ArrayBuilder
+{
+public:
+    constexpr ArrayBuilder() = default;
+    constexpr ArrayBuilder(Item item)
+    {
+        append(std::move(item));
+    }
+    constexpr ArrayBuilder& operator()(Item item) &
+    {
+        append(std::move(item));
+        return *this;
+    }
+    constexpr ArrayBuilder&& operator()(Item item) &&
+    {
+        append(std::move(item));
+        return std::move(*this);
+    }
+    constexpr std::size_t size() const
+    {
+        return count;
+    }
+    constexpr operator std::array<Item, N>() const&
+    {
+        return collection;
+    }
+    constexpr operator std::array<Item, N>() &&
+    {
+        return std::move(collection);
+    }
+private:
+    constexpr void append(Item&& item)
+    {
+        if (count == N)
+            throw std::out_of_range("array builder is full");
+        collection[count++] = std::move(item);
+    }
+private:
+    std::array<Item, N> collection{};
+    std::size_t count = 0;
+};
 
-// TODO MapBuilder
 // TODO boost::assign_detail::converter
 
 } // namespace collection
+
+#endif // BUILDER_HPP
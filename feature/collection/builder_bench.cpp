@@ -0,0 +1,74 @@
+#include "builder.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+static std::vector<int> randomKeys(std::size_t size)
+{
+    std::mt19937 generator(42);
+    std::vector<int> keys(size);
+    for (int& key : keys)
+        key = static_cast<int>(generator());
+    return keys;
+}
+
+static void BM_MapBuilder(benchmark::State& state)
+{
+    const std::vector<int> keys = randomKeys(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        collection::MapBuilder<int, int> builder;
+        for (int key : keys)
+            builder.emplace(key, key);
+        std::map<int, int> map = std::move(builder);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MapBuilder)->Range(1 << 10, 100000);
+
+static void BM_FlatMapBuilder(benchmark::State& state)
+{
+    const std::vector<int> keys = randomKeys(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        collection::FlatMapBuilder<int, int> builder;
+        builder.reserve(keys.size());
+        for (int key : keys)
+            builder.emplace(key, key);
+        collection::FlatMap<int, int> map = std::move(builder);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlatMapBuilder)->Range(1 << 10, 100000);
+
+template <typename Map>
+static void lookup(benchmark::State& state, const Map& map, const std::vector<int>& keys)
+{
+    for (auto _ : state)
+    {
+        for (int key : keys)
+            benchmark::DoNotOptimize(map.find(key));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+static void BM_MapLookup(benchmark::State& state)
+{
+    const std::vector<int> keys = randomKeys(static_cast<std::size_t>(state.range(0)));
+    collection::MapBuilder<int, int> builder;
+    for (int key : keys)
+        builder.emplace(key, key);
+    lookup(state, std::map<int, int>(std::move(builder)), keys);
+}
+BENCHMARK(BM_MapLookup)->Range(1 << 10, 100000);
+
+static void BM_FlatMapLookup(benchmark::State& state)
+{
+    const std::vector<int> keys = randomKeys(static_cast<std::size_t>(state.range(0)));
+    collection::FlatMapBuilder<int, int> builder;
+    for (int key : keys)
+        builder.emplace(key, key);
+    lookup(state, collection::FlatMap<int, int>(std::move(builder)), keys);
+}
+BENCHMARK(BM_FlatMapLookup)->Range(1 << 10, 100000);
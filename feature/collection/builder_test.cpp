@@ -1,6 +1,9 @@
 #include "builder.hpp"
+#include "static_map.hpp"
 #include <boost/assign/list_of.hpp>
 #include <gtest/gtest.h>
+#include <memory>
+#include <string_view>
 
 TEST(CollectionBuilderTest, BuildVector)
 {
@@ -19,3 +22,185 @@ TEST(CollectionBuilderTest, BuildList)
     ASSERT_EQ(stdList, builderList);
     ASSERT_EQ(stdList, boostList);
 }
+
+struct CopyCounter
+{
+    CopyCounter(int v = 0) : value(v)
+    {
+    }
+    CopyCounter(const CopyCounter& other) : value(other.value)
+    {
+        ++copies;
+    }
+    CopyCounter(CopyCounter&& other) noexcept : value(other.value)
+    {
+    }
+    CopyCounter& operator=(const CopyCounter& other)
+    {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    CopyCounter& operator=(CopyCounter&& other) noexcept
+    {
+        value = other.value;
+        return *this;
+    }
+    int value;
+    static int copies;
+};
+
+int CopyCounter::copies = 0;
+
+TEST(CollectionBuilderTest, BuildWithoutCopies)
+{
+    CopyCounter::copies = 0;
+    std::vector<CopyCounter> vector{
+        collection::VectorBuilder<CopyCounter>().reserve(3)(CopyCounter(1)).emplace(2)(3)};
+    ASSERT_EQ(3u, vector.size());
+    EXPECT_EQ(3, vector.back().value);
+    EXPECT_EQ(0, CopyCounter::copies);
+}
+
+TEST(CollectionBuilderTest, BuildMoveOnly)
+{
+    std::vector<std::unique_ptr<int>> vector{collection::VectorBuilder<std::unique_ptr<int>>(
+        std::unique_ptr<int>(new int(1)))(std::unique_ptr<int>(new int(2)))};
+    ASSERT_EQ(2u, vector.size());
+    EXPECT_EQ(2, *vector[1]);
+}
+
+TEST(CollectionBuilderTest, BuildFromLvalueBuilder)
+{
+    collection::ListBuilder<int> builder(1);
+    builder(2).emplace(3);
+    std::list<int> first = builder;
+    std::list<int> second = builder;
+    EXPECT_EQ(first, second);
+    EXPECT_EQ((std::list<int>{1, 2, 3}), first);
+}
+
+TEST(CollectionBuilderTest, BuildArray)
+{
+    std::array<int, 3> array = collection::ArrayBuilder<int, 3>(1)(2)(3);
+    EXPECT_EQ((std::array<int, 3>{{1, 2, 3}}), array);
+    std::array<int, 3> partial = collection::ArrayBuilder<int, 3>(1);
+    EXPECT_EQ((std::array<int, 3>{{1, 0, 0}}), partial);
+    EXPECT_THROW((collection::ArrayBuilder<int, 1>(1)(2)), std::out_of_range);
+}
+
+TEST(CollectionBuilderTest, BuildMap)
+{
+    std::map<int, std::string> stdMap{{1, "one"}, {2, "two"}, {3, "three"}};
+    std::map<int, std::string> builderMap{
+        collection::MapBuilder<int, std::string>({2, "two"}).emplace(1, "one")({3, "three"})(
+            {1, "duplicate"})};
+    std::map<int, std::string> boostMap{
+        boost::assign::map_list_of(1, "one")(2, "two")(3, "three")};
+    ASSERT_EQ(stdMap, builderMap);
+    ASSERT_EQ(stdMap, boostMap);
+}
+
+TEST(CollectionBuilderTest, BuildFlatMap)
+{
+    collection::FlatMap<int, std::string> flatMap{
+        collection::FlatMapBuilder<int, std::string>().reserve(4)({3, "three"}).emplace(
+            1, "one")({2, "two"})({1, "duplicate"})};
+    ASSERT_EQ(3u, flatMap.size());
+    EXPECT_EQ("one", flatMap.at(1));
+    EXPECT_EQ("two", flatMap.at(2));
+    EXPECT_EQ("three", flatMap.at(3));
+    EXPECT_EQ(flatMap.end(), flatMap.find(4));
+    EXPECT_EQ(0u, flatMap.count(0));
+    EXPECT_THROW(flatMap.at(4), std::out_of_range);
+
+    std::vector<int> keys;
+    for (const auto& item : flatMap)
+        keys.push_back(item.first);
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), keys);
+}
+
+TEST(CollectionBuilderTest, BuildFlatMapFromLvalueBuilder)
+{
+    collection::FlatMapBuilder<int, int, std::greater<int>> builder({1, 10});
+    builder({3, 30})({2, 20});
+    collection::FlatMap<int, int, std::greater<int>> first = builder;
+    collection::FlatMap<int, int, std::greater<int>> second = std::move(builder);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(30, first.begin()->second);
+}
+
+// компаратор с состоянием: не создаётся по умолчанию внутри коллекции
+struct ModuloLess
+{
+    int modulo;
+    constexpr bool operator()(int lhs, int rhs) const
+    {
+        return lhs % modulo < rhs % modulo;
+    }
+};
+
+TEST(CollectionBuilderTest, BuildWithComparatorInstance)
+{
+    collection::FlatMap<int, int, ModuloLess> flatMap =
+        collection::FlatMapBuilder<int, int, ModuloLess>(ModuloLess{10})({12, 1})({21, 2})(
+            {32, 3});
+    ASSERT_EQ(2u, flatMap.size());
+    EXPECT_EQ(2, flatMap.at(1));
+    EXPECT_EQ(1, flatMap.at(42));
+    EXPECT_EQ(flatMap.end(), flatMap.find(3));
+    EXPECT_EQ(10, flatMap.key_comp().modulo);
+
+    std::map<int, int, ModuloLess> map =
+        collection::MapBuilder<int, int, ModuloLess>(ModuloLess{3})({1, 1})({4, 4})({2, 2});
+    ASSERT_EQ(2u, map.size());
+    EXPECT_EQ(1, map.at(7));
+}
+
+TEST(CollectionBuilderTest, BuildConstexprArray)
+{
+    static constexpr std::array<int, 4> array = collection::ArrayBuilder<int, 4>(1)(2)(3)(4);
+    static_assert(array[0] == 1 && array[3] == 4, "array is built at compile time");
+    EXPECT_EQ((std::array<int, 4>{{1, 2, 3, 4}}), array);
+}
+
+TEST(CollectionBuilderTest, BuildStaticMap)
+{
+    static constexpr auto codes = collection::makeStaticMap<std::string_view, int>(
+        {{"not_found", 404}, {"ok", 200}, {"created", 201}, {"bad_request", 400}});
+    static_assert(codes.size() == 4, "static map size");
+    static_assert(codes.at("ok") == 200, "lookup at compile time");
+    static_assert(!codes.contains("teapot"), "missing key at compile time");
+    static_assert(codes.begin()->key == "bad_request", "entries are sorted");
+
+    EXPECT_EQ(404, codes.at("not_found"));
+    EXPECT_EQ(nullptr, codes.find("teapot"));
+    EXPECT_THROW(codes.at("teapot"), std::out_of_range);
+
+    static constexpr collection::StaticMap<int, char, 3> letters(
+        std::array<std::pair<int, char>, 3>{{{3, 'c'}, {1, 'a'}, {2, 'b'}}});
+    static_assert(letters.at(2) == 'b', "constructed from std::array");
+    std::string ordered;
+    for (const auto& entry : letters)
+        ordered += entry.value;
+    EXPECT_EQ("abc", ordered);
+}
+
+TEST(CollectionBuilderTest, StaticMapDuplicateKey)
+{
+    using Map = collection::StaticMap<int, int, 2>;
+    EXPECT_THROW(Map({{1, 1}, {1, 2}}), std::logic_error);
+}
+
+TEST(CollectionBuilderTest, StaticMapComparatorInstance)
+{
+    static constexpr auto residues =
+        collection::makeStaticMap<int, char>({{12, 'b'}, {20, 'a'}, {33, 'c'}}, ModuloLess{10});
+    static_assert(residues.at(42) == 'b', "lookup with the stored comparator");
+    static_assert(!residues.contains(4), "missing residue");
+    static_assert(residues.begin()->key == 20, "sorted by the stored comparator");
+    EXPECT_EQ(10, residues.key_comp().modulo);
+
+    using Map = collection::StaticMap<int, int, 2, ModuloLess>;
+    EXPECT_THROW(Map({{1, 1}, {4, 4}}, ModuloLess{3}), std::logic_error);
+}
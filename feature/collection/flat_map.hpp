@@ -0,0 +1,143 @@
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace collection
+{
+
+namespace detail
+{
+struct FlatAppender;
+} // namespace detail
+
+/**
+ * Таблица поиска на отсортированном векторе пар
+ * @note Заполняется целиком при создании, после чего доступна только для чтения
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using key_compare = Compare;
+    using container_type = std::vector<value_type>;
+    using size_type = typename container_type::size_type;
+    using const_iterator = typename container_type::const_iterator;
+public:
+    FlatMap() = default;
+    explicit FlatMap(const Compare& compare) : m_compare(compare)
+    {
+    }
+    /**
+     * Создать из произвольных пар: одна сортировка и удаление повторов
+     * @note При повторе ключа остаётся первая пара, как у std::map::emplace
+     */
+    explicit FlatMap(container_type items, const Compare& compare = Compare())
+        : m_items(std::move(items)), m_compare(compare)
+    {
+        normalize();
+    }
+public:
+    const_iterator begin() const
+    {
+        return m_items.begin();
+    }
+    const_iterator end() const
+    {
+        return m_items.end();
+    }
+    size_type size() const
+    {
+        return m_items.size();
+    }
+    bool empty() const
+    {
+        return m_items.empty();
+    }
+    void reserve(size_type size)
+    {
+        m_items.reserve(size);
+    }
+    key_compare key_comp() const
+    {
+        return m_compare;
+    }
+    const_iterator lower_bound(const Key& key) const
+    {
+        return std::lower_bound(m_items.begin(), m_items.end(), key,
+                                [this](const value_type& item, const Key& k)
+                                { return m_compare(item.first, k); });
+    }
+    const_iterator find(const Key& key) const
+    {
+        const_iterator it = lower_bound(key);
+        return it != m_items.end() && !m_compare(key, it->first) ? it : m_items.end();
+    }
+    size_type count(const Key& key) const
+    {
+        return find(key) != m_items.end() ? 1 : 0;
+    }
+    const Value& at(const Key& key) const
+    {
+        const_iterator it = find(key);
+        if (it == m_items.end())
+            throw std::out_of_range("key is not found");
+        return it->second;
+    }
+    friend bool operator==(const FlatMap& lhs, const FlatMap& rhs)
+    {
+        return lhs.m_items == rhs.m_items;
+    }
+    friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs)
+    {
+        return !(lhs == rhs);
+    }
+private:
+    friend struct detail::FlatAppender;
+    void normalize()
+    {
+        const Compare& compare = m_compare;
+        std::stable_sort(m_items.begin(), m_items.end(),
+                         [&compare](const value_type& lhs, const value_type& rhs)
+                         { return compare(lhs.first, rhs.first); });
+        m_items.erase(std::unique(m_items.begin(), m_items.end(),
+                                  [&compare](const value_type& lhs, const value_type& rhs)
+                                  { return !compare(lhs.first, rhs.first); }),
+                      m_items.end());
+    }
+private:
+    container_type m_items;
+    Compare m_compare{};
+};
+
+namespace detail
+{
+
+// накопление пар без сортировки, сортировка один раз при завершении
+struct FlatAppender
+{
+    template <typename Map, typename... Args>
+    static void append(Map& map, Args&&... args)
+    {
+        map.m_items.emplace_back(std::forward<Args>(args)...);
+    }
+    template <typename Map>
+    static void finish(Map& map)
+    {
+        map.normalize();
+    }
+};
+
+} // namespace detail
+
+} // namespace collection
+
+#endif // FLAT_MAP_HPP
@@ -0,0 +1,139 @@
+#ifndef STATIC_MAP_HPP
+#define STATIC_MAP_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace collection
+{
+
+/**
+ * Таблица поиска, сортируемая на этапе компиляции
+ * @note В static constexpr контексте размещается в .rodata и не требует инициализации при
+ * запуске; повтор ключа в constexpr контексте - ошибка компиляции
+ */
+template <typename Key, typename Value, std::size_t N, typename Compare = std::less<Key>>
+class StaticMap
+{
+public:
+    struct Entry
+    {
+        Key key;
+        Value value;
+    };
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = Entry;
+    using key_compare = Compare;
+    using size_type = std::size_t;
+    using const_iterator = typename std::array<Entry, N>::const_iterator;
+public:
+    constexpr explicit StaticMap(const std::pair<Key, Value> (&items)[N],
+                                 const Compare& compare = Compare())
+        : m_compare(compare)
+    {
+        for (size_type i = 0; i < N; ++i)
+            m_entries[i] = Entry{items[i].first, items[i].second};
+        sort();
+    }
+    constexpr explicit StaticMap(const std::array<std::pair<Key, Value>, N>& items,
+                                 const Compare& compare = Compare())
+        : m_compare(compare)
+    {
+        for (size_type i = 0; i < N; ++i)
+            m_entries[i] = Entry{items[i].first, items[i].second};
+        sort();
+    }
+public:
+    constexpr const_iterator begin() const
+    {
+        return m_entries.begin();
+    }
+    constexpr const_iterator end() const
+    {
+        return m_entries.end();
+    }
+    constexpr size_type size() const
+    {
+        return N;
+    }
+    constexpr key_compare key_comp() const
+    {
+        return m_compare;
+    }
+    /**
+     * Найти значение двоичным поиском
+     * @return nullptr, если ключа нет
+     */
+    constexpr const Value* find(const Key& key) const
+    {
+        const size_type i = index(key);
+        return i < N ? &m_entries[i].value : nullptr;
+    }
+    constexpr bool contains(const Key& key) const
+    {
+        return index(key) < N;
+    }
+    constexpr const Value& at(const Key& key) const
+    {
+        const size_type i = index(key);
+        if (i == N)
+            throw std::out_of_range("key is not found");
+        return m_entries[i].value;
+    }
+private:
+    // позиция ключа или N; без сравнения указателей, которое -fsanitize=undefined
+    // делает неконстантным выражением
+    constexpr size_type index(const Key& key) const
+    {
+        size_type first = 0;
+        size_type last = N;
+        while (first < last)
+        {
+            const size_type middle = first + (last - first) / 2;
+            if (m_compare(m_entries[middle].key, key))
+                first = middle + 1;
+            else
+                last = middle;
+        }
+        return first < N && !m_compare(key, m_entries[first].key) ? first : N;
+    }
+private:
+    // сортировка вставками: std::sort и std::swap не constexpr в C++17
+    constexpr void sort()
+    {
+        for (size_type i = 1; i < N; ++i)
+        {
+            Entry entry = m_entries[i];
+            size_type j = i;
+            for (; j > 0 && m_compare(entry.key, m_entries[j - 1].key); --j)
+                m_entries[j] = m_entries[j - 1];
+            m_entries[j] = entry;
+        }
+        for (size_type i = 1; i < N; ++i)
+        {
+            if (!m_compare(m_entries[i - 1].key, m_entries[i].key))
+                throw std::logic_error("duplicate key in static map");
+        }
+    }
+private:
+    Compare m_compare;
+    std::array<Entry, N> m_entries{};
+};
+
+/**
+ * Создать таблицу с выводом размера: makeStaticMap<int, char>({{1, 'a'}, {2, 'b'}})
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>, std::size_t N>
+constexpr StaticMap<Key, Value, N, Compare> makeStaticMap(const std::pair<Key, Value> (&items)[N],
+                                                          const Compare& compare = Compare())
+{
+    return StaticMap<Key, Value, N, Compare>(items, compare);
+}
+
+} // namespace collection
+
+#endif // STATIC_MAP_HPP
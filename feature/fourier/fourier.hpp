@@ -0,0 +1,221 @@
+#ifndef FOURIER_HPP
+#define FOURIER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace fourier
+{
+
+inline unsigned int nextPow2(const unsigned int n)
+{
+    unsigned int pow2 = 1;
+    while (pow2 < n)
+        pow2 <<= 1;
+    return pow2;
+}
+
+template <typename T>
+std::vector<std::complex<T>> toComplex(const std::vector<T>& samples)
+{
+    std::vector<std::complex<T>> complexSamples(samples.size());
+    std::transform(samples.begin(), samples.end(), complexSamples.begin(),
+                   [](const T sample) { return std::complex<T>(sample, 0); });
+    return complexSamples;
+}
+
+template <typename T>
+std::vector<T> toAmplSpectrum(const std::vector<std::complex<T>>& complexSamples)
+{
+    std::vector<T> samples(complexSamples.size());
+    std::transform(complexSamples.begin(), complexSamples.end(), samples.begin(),
+                   [](const std::complex<T> complexSample) { return std::abs(complexSample); });
+    return samples;
+}
+
+template <typename T>
+std::vector<T> toPhaseSpectrum(const std::vector<std::complex<T>>& complexSamples)
+{
+    std::vector<T> samples(complexSamples.size());
+    std::transform(complexSamples.begin(), complexSamples.end(), samples.begin(),
+                   [](const std::complex<T> complexSample) { return std::arg(complexSample); });
+    return samples;
+}
+
+template <typename T>
+std::vector<std::complex<T>> dft(const std::vector<std::complex<T>>& complexSamples)
+{
+    const unsigned int N = complexSamples.size();
+    std::vector<std::complex<T>> spectrum(N);
+
+    for (unsigned int k = 0; k < N; k++)
+        for (unsigned int n = 0; n < N; n++)
+            spectrum[k] +=
+                complexSamples[n] * (std::complex<T>)std::polar(1.0, -2.0 * M_PI * k * n / N);
+
+    return spectrum;
+}
+
+template <typename T>
+std::vector<std::complex<T>> fftN2(std::vector<std::complex<T>>& complexSamples)
+{
+    const unsigned int N = nextPow2(complexSamples.size());
+    complexSamples.resize(N, std::complex<T>());
+
+    if (N == 1)
+        return dft(complexSamples);
+
+    const unsigned int M = N / 2;
+    std::vector<std::complex<T>> evenComplexSamples(M);
+    std::vector<std::complex<T>> oddComplexSamples(M);
+
+    for (unsigned int k = 0; k < M; k++)
+    {
+        evenComplexSamples[k] = complexSamples[2 * k];
+        oddComplexSamples[k] = complexSamples[2 * k + 1];
+    }
+
+    evenComplexSamples = fftN2<T>(evenComplexSamples);
+    oddComplexSamples = fftN2<T>(oddComplexSamples);
+
+    std::vector<std::complex<T>> spectrum(N);
+    for (unsigned long k = 0; k < M; k++)
+    {
+        spectrum[k] = evenComplexSamples[k] +
+                      (std::complex<T>)std::polar(1.0, -2.0 * M_PI * k / N) * oddComplexSamples[k];
+        spectrum[k + M] =
+            evenComplexSamples[k] -
+            (std::complex<T>)std::polar(1.0, -2.0 * M_PI * k / N) * oddComplexSamples[k];
+    }
+
+    return spectrum;
+}
+
+/**
+ * Спектр только в выбранных бинах (алгоритм Гёрцеля)
+ * @return spectrum[i] совпадает с dft(toComplex(samples))[bins[i]]
+ * @note O(N) на бин вместо O(N log N) на весь спектр; внутренний цикл идёт по бинам
+ * над непрерывными массивами состояний и векторизуется компилятором
+ */
+template <typename T>
+std::vector<std::complex<T>> goertzel(const std::vector<T>& samples,
+                                      const std::vector<unsigned int>& bins)
+{
+    const unsigned int N = samples.size();
+    const size_t K = bins.size();
+    if (N == 0)
+        return std::vector<std::complex<T>>(K);
+    std::vector<T> coeffs(K);
+    std::vector<T> s1(K, T());
+    std::vector<T> s2(K, T());
+    for (size_t k = 0; k < K; k++)
+        coeffs[k] = static_cast<T>(2.0 * std::cos(2.0 * M_PI * bins[k] / N));
+
+    for (unsigned int n = 0; n < N; n++)
+    {
+        const T sample = samples[n];
+        for (size_t k = 0; k < K; k++)
+        {
+            const T s0 = sample + coeffs[k] * s1[k] - s2[k];
+            s2[k] = s1[k];
+            s1[k] = s0;
+        }
+    }
+
+    // X[k] = e^(i w) * s1 - s2 после N отсчётов
+    std::vector<std::complex<T>> spectrum(K);
+    for (size_t k = 0; k < K; k++)
+        spectrum[k] = (std::complex<T>)std::polar(1.0, 2.0 * M_PI * bins[k] / N) * s1[k] - s2[k];
+    return spectrum;
+}
+
+/**
+ * Скользящее ДПФ: выбранные бины окна из последних N отсчётов
+ * @note Каждый отсчёт обновляет бины за O(1) на бин. Накопленная погрешность
+ * сбрасывается каждые N отсчётов спектром Гёрцеля, который считается по ходу прохода
+ * окна, по шагу на отсчёт: стоимость push постоянна, без всплеска O(N) на бин
+ */
+template <typename T>
+class SlidingDft
+{
+public:
+    SlidingDft(unsigned int size, std::vector<unsigned int> bins)
+        : m_bins(std::move(bins)), m_window(size, T()), m_spectrum(m_bins.size()),
+          m_twiddles(m_bins.size()), m_coeffs(m_bins.size()), m_s1(m_bins.size(), T()),
+          m_s2(m_bins.size(), T())
+    {
+        if (size == 0)
+            throw std::invalid_argument("sliding DFT window must not be empty");
+        for (size_t k = 0; k < m_bins.size(); k++)
+        {
+            m_twiddles[k] = (std::complex<T>)std::polar(1.0, 2.0 * M_PI * m_bins[k] / size);
+            m_coeffs[k] = static_cast<T>(2.0 * std::cos(2.0 * M_PI * m_bins[k] / size));
+        }
+    }
+    /**
+     * Сдвинуть окно на один отсчёт
+     */
+    void push(const T sample)
+    {
+        const T delta = sample - m_window[m_position];
+        m_window[m_position] = sample;
+        // за проход окно заполняется по порядку, поэтому шаг Гёрцеля идёт вместе с push
+        for (size_t k = 0; k < m_spectrum.size(); k++)
+        {
+            const T s0 = sample + m_coeffs[k] * m_s1[k] - m_s2[k];
+            m_s2[k] = m_s1[k];
+            m_s1[k] = s0;
+        }
+        if (++m_position == m_window.size())
+        {
+            // окно снова в хронологическом порядке, как в goertzel(m_window, m_bins)
+            m_position = 0;
+            for (size_t k = 0; k < m_spectrum.size(); k++)
+            {
+                m_spectrum[k] = m_twiddles[k] * m_s1[k] - m_s2[k];
+                m_s1[k] = T();
+                m_s2[k] = T();
+            }
+            return;
+        }
+        for (size_t k = 0; k < m_spectrum.size(); k++)
+            m_spectrum[k] = (m_spectrum[k] + delta) * m_twiddles[k];
+    }
+    const std::vector<unsigned int>& bins() const
+    {
+        return m_bins;
+    }
+    /**
+     * Комплексный спектр в бинах; окно до заполнения дополнено нулями слева
+     */
+    const std::vector<std::complex<T>>& spectrum() const
+    {
+        return m_spectrum;
+    }
+    std::vector<T> amplSpectrum() const
+    {
+        return toAmplSpectrum(m_spectrum);
+    }
+    std::vector<T> phaseSpectrum() const
+    {
+        return toPhaseSpectrum(m_spectrum);
+    }
+private:
+    std::vector<unsigned int> m_bins;
+    std::vector<T> m_window;
+    size_t m_position = 0;
+    std::vector<std::complex<T>> m_spectrum;
+    std::vector<std::complex<T>> m_twiddles;
+    // состояние Гёрцеля по текущему проходу окна
+    std::vector<T> m_coeffs;
+    std::vector<T> m_s1;
+    std::vector<T> m_s2;
+};
+
+} // namespace fourier
+
+#endif // FOURIER_HPP
@@ -0,0 +1,111 @@
+#include "fourier.hpp"
+#include "../perf/perf.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+static std::vector<std::complex<double>> randomSamples(std::size_t size)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    std::vector<double> samples(size);
+    for (double& sample : samples)
+        sample = distribution(generator);
+    return fourier::toComplex(samples);
+}
+
+// аппаратные счётчики на итерацию, если perf_event_open доступен
+static void setCounters(benchmark::State& state, const perf::Counters& counters,
+                        const perf::Sample& sample)
+{
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    if (!counters.available())
+        return;
+    state.counters["cycles"] = benchmark::Counter(static_cast<double>(sample.cycles),
+                                                  benchmark::Counter::kAvgIterations);
+    state.counters["instructions"] = benchmark::Counter(static_cast<double>(sample.instructions),
+                                                        benchmark::Counter::kAvgIterations);
+    state.counters["cache_misses"] = benchmark::Counter(static_cast<double>(sample.cacheMisses),
+                                                        benchmark::Counter::kAvgIterations);
+}
+
+static void BM_Dft(benchmark::State& state)
+{
+    const std::vector<std::complex<double>> samples =
+        randomSamples(static_cast<std::size_t>(state.range(0)));
+    perf::Counters counters;
+    counters.start();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(fourier::dft(samples));
+    setCounters(state, counters, counters.stop());
+}
+BENCHMARK(BM_Dft)->RangeMultiplier(4)->Range(16, 1 << 10);
+
+static void BM_FftN2(benchmark::State& state)
+{
+    const std::vector<std::complex<double>> samples =
+        randomSamples(static_cast<std::size_t>(state.range(0)));
+    perf::Counters counters;
+    counters.start();
+    for (auto _ : state)
+    {
+        std::vector<std::complex<double>> input = samples;
+        benchmark::DoNotOptimize(fourier::fftN2(input));
+    }
+    setCounters(state, counters, counters.stop());
+}
+BENCHMARK(BM_FftN2)->RangeMultiplier(4)->Range(16, 1 << 16);
+
+// четыре бина: частоты тонального набора на окне N
+static void BM_Goertzel(benchmark::State& state)
+{
+    const std::vector<std::complex<double>> complexSamples =
+        randomSamples(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> samples(complexSamples.size());
+    for (std::size_t i = 0; i < samples.size(); i++)
+        samples[i] = complexSamples[i].real();
+    const std::vector<unsigned int> bins = {7, 11, 13, 17};
+    perf::Counters counters;
+    counters.start();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(fourier::goertzel(samples, bins));
+    setCounters(state, counters, counters.stop());
+}
+BENCHMARK(BM_Goertzel)->RangeMultiplier(4)->Range(16, 1 << 16);
+
+static void BM_SlidingDftPush(benchmark::State& state)
+{
+    fourier::SlidingDft<double> sliding(static_cast<unsigned int>(state.range(0)),
+                                        {7, 11, 13, 17});
+    double sample = 0.;
+    for (auto _ : state)
+    {
+        sliding.push(sample);
+        sample += 0.001;
+        benchmark::DoNotOptimize(sliding.spectrum().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SlidingDftPush)->RangeMultiplier(16)->Range(64, 1 << 12);
+
+// задержка отдельного push: среднее скрывает редкие пересчёты окна
+static void BM_SlidingDftPushLatency(benchmark::State& state)
+{
+    fourier::SlidingDft<double> sliding(static_cast<unsigned int>(state.range(0)),
+                                        {7, 11, 13, 17});
+    perf::Histogram latency;
+    double sample = 0.;
+    for (auto _ : state)
+    {
+        {
+            perf::ScopedTimer timer(latency);
+            sliding.push(sample);
+        }
+        sample += 0.001;
+        benchmark::DoNotOptimize(sliding.spectrum().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["p50_ns"] = static_cast<double>(latency.percentile(0.5));
+    state.counters["p99_ns"] = static_cast<double>(latency.percentile(0.99));
+    state.counters["max_ns"] = static_cast<double>(latency.max());
+}
+BENCHMARK(BM_SlidingDftPushLatency)->RangeMultiplier(16)->Range(64, 1 << 12);
@@ -0,0 +1,86 @@
+#include "fourier.hpp"
+#include <gtest/gtest.h>
+#include <random>
+
+static std::vector<double> randomSamples(size_t size, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    std::vector<double> samples(size);
+    for (double& sample : samples)
+        sample = distribution(generator);
+    return samples;
+}
+
+static void expectNear(const std::complex<double>& expected, const std::complex<double>& actual)
+{
+    EXPECT_NEAR(expected.real(), actual.real(), 1e-9);
+    EXPECT_NEAR(expected.imag(), actual.imag(), 1e-9);
+}
+
+TEST(FourierTest, FftMatchesDft)
+{
+    std::vector<std::complex<double>> samples = fourier::toComplex(randomSamples(64, 1));
+    const std::vector<std::complex<double>> expected = fourier::dft(samples);
+    const std::vector<std::complex<double>> actual = fourier::fftN2(samples);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t k = 0; k < expected.size(); k++)
+        expectNear(expected[k], actual[k]);
+}
+
+TEST(FourierTest, GoertzelMatchesDft)
+{
+    const std::vector<double> samples = randomSamples(100, 2);
+    const std::vector<unsigned int> bins = {0, 1, 7, 50, 99};
+    const std::vector<std::complex<double>> expected = fourier::dft(fourier::toComplex(samples));
+    const std::vector<std::complex<double>> actual = fourier::goertzel(samples, bins);
+    ASSERT_EQ(bins.size(), actual.size());
+    for (size_t i = 0; i < bins.size(); i++)
+        expectNear(expected[bins[i]], actual[i]);
+
+    EXPECT_TRUE(fourier::goertzel(samples, {}).empty());
+    EXPECT_EQ(std::complex<double>(), fourier::goertzel(std::vector<double>(), {3}).at(0));
+}
+
+TEST(FourierTest, GoertzelDetectsTone)
+{
+    const unsigned int N = 256;
+    std::vector<double> samples(N);
+    for (unsigned int n = 0; n < N; n++)
+        samples[n] = std::cos(2.0 * M_PI * 20 * n / N);
+
+    const std::vector<double> amplitudes =
+        fourier::toAmplSpectrum(fourier::goertzel(samples, {10, 20, 30}));
+    EXPECT_NEAR(0., amplitudes[0], 1e-9);
+    EXPECT_NEAR(N / 2., amplitudes[1], 1e-9);
+    EXPECT_NEAR(0., amplitudes[2], 1e-9);
+}
+
+TEST(FourierTest, SlidingDftMatchesDftOfWindow)
+{
+    const unsigned int N = 32;
+    const std::vector<unsigned int> bins = {1, 5, 16};
+    const std::vector<double> samples = randomSamples(3 * N + 7, 3);
+    fourier::SlidingDft<double> sliding(N, bins);
+
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        sliding.push(samples[i]);
+        std::vector<double> window(N, 0.);
+        for (size_t j = 0; j < N && j <= i; j++)
+            window[N - 1 - j] = samples[i - j];
+        const std::vector<std::complex<double>> expected = fourier::dft(fourier::toComplex(window));
+        for (size_t b = 0; b < bins.size(); b++)
+            expectNear(expected[bins[b]], sliding.spectrum()[b]);
+    }
+
+    const std::vector<double> amplitudes = sliding.amplSpectrum();
+    const std::vector<double> phases = sliding.phaseSpectrum();
+    ASSERT_EQ(bins.size(), amplitudes.size());
+    for (size_t b = 0; b < bins.size(); b++)
+    {
+        EXPECT_DOUBLE_EQ(std::abs(sliding.spectrum()[b]), amplitudes[b]);
+        EXPECT_DOUBLE_EQ(std::arg(sliding.spectrum()[b]), phases[b]);
+    }
+    EXPECT_THROW(fourier::SlidingDft<double>(0, bins), std::invalid_argument);
+}
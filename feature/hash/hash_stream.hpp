@@ -1,6 +1,7 @@
 #ifndef HASH_STREAM_H
 #define HASH_STREAM_H
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <openssl/evp.h>
@@ -47,6 +48,10 @@ public:
     {
         return m_data.data();
     }
+    const unsigned char* data() const
+    {
+        return m_data.data();
+    }
     size_t size() const
     {
         return m_data.size();
@@ -68,6 +73,14 @@ public:
         }
         return oss.str();
     }
+    friend bool operator==(const Hash& lhs, const Hash& rhs)
+    {
+        return lhs.m_data == rhs.m_data;
+    }
+    friend bool operator!=(const Hash& lhs, const Hash& rhs)
+    {
+        return !(lhs == rhs);
+    }
 private:
     std::vector<unsigned char> m_data;
 };
@@ -127,6 +140,157 @@ private:
     EVP_MD_CTX* m_md_ctx;
 };
 
+/**
+ * Буфер-тройник: передаёт данные другому буферу блоками и хэширует тот же блок,
+ * пока он ещё в кэше
+ * @note Экземпляр используется в одном направлении: либо чтение, либо запись.
+ * При чтении хэш покрывает блоки, уже прочитанные из источника, и совпадает
+ * с хэшем всех данных по достижении конца потока
+ */
+class TeeHashBuf : public std::streambuf
+{
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+public:
+    explicit TeeHashBuf(std::streambuf* target, const EVP_MD* md_type = EVP_sha256(),
+                        size_t block_size = DEFAULT_BLOCK_SIZE)
+        : m_target(target), m_md_type(md_type), m_md_ctx(nullptr),
+          m_buffer(std::max<size_t>(block_size, 1))
+    {
+        ASSERT_NOT_NULL(m_target);
+        m_md_ctx = EVP_MD_CTX_new();
+        ASSERT_NOT_NULL(m_md_ctx);
+        OSSL_ASSERT(EVP_DigestInit_ex(m_md_ctx, md_type, NULL));
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    }
+    TeeHashBuf(const TeeHashBuf&) = delete;
+    TeeHashBuf& operator=(const TeeHashBuf&) = delete;
+    ~TeeHashBuf()
+    {
+        try
+        {
+            flushBlock();
+        }
+        catch (...)
+        {
+        }
+        EVP_MD_CTX_free(m_md_ctx);
+    }
+    /**
+     * Получить хэш прошедших данных
+     * @attention Записанное передаётся получателю, контекст сбрасывается
+     */
+    Hash getHash()
+    {
+        if (!flushBlock())
+            throw std::runtime_error("Failed to write to target buffer");
+        Hash result(EVP_MAX_MD_SIZE);
+        unsigned int len = 0;
+        OSSL_ASSERT(EVP_DigestFinal_ex(m_md_ctx, result.data(), &len));
+        result.resize(len);
+        OSSL_ASSERT(EVP_DigestInit_ex(m_md_ctx, m_md_type, NULL));
+        return result;
+    }
+protected:
+    // блок записи заполнен
+    int_type overflow(int_type ch) override
+    {
+        if (!flushBlock())
+            return traits_type::eof();
+        if (ch == traits_type::eof())
+            return traits_type::not_eof(ch);
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+        return ch;
+    }
+    // большие записи идут к получателю напрямую, минуя копирование в блок
+    std::streamsize xsputn(const char* s, std::streamsize count) override
+    {
+        const std::streamsize space = epptr() - pptr();
+        if (count <= space)
+        {
+            std::copy(s, s + count, pptr());
+            pbump(static_cast<int>(count));
+            return count;
+        }
+        if (!flushBlock())
+            return 0;
+        if (count < static_cast<std::streamsize>(m_buffer.size()))
+        {
+            std::copy(s, s + count, pptr());
+            pbump(static_cast<int>(count));
+            return count;
+        }
+        const std::streamsize written = m_target->sputn(s, count);
+        update(s, written);
+        return written;
+    }
+    int sync() override
+    {
+        return flushBlock() && m_target->pubsync() == 0 ? 0 : -1;
+    }
+    // прочитать следующий блок источника
+    int_type underflow() override
+    {
+        const std::streamsize count =
+            m_target->sgetn(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        if (count <= 0)
+            return traits_type::eof();
+        update(m_buffer.data(), count);
+        setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + count);
+        return traits_type::to_int_type(*gptr());
+    }
+    // большие чтения идут из источника сразу в буфер вызывающего
+    std::streamsize xsgetn(char* s, std::streamsize count) override
+    {
+        std::streamsize done = std::min<std::streamsize>(count, egptr() - gptr());
+        std::copy(gptr(), gptr() + done, s);
+        gbump(static_cast<int>(done));
+        while (done < count)
+        {
+            const std::streamsize rest = count - done;
+            if (rest < static_cast<std::streamsize>(m_buffer.size()))
+            {
+                if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+                    break;
+                const std::streamsize chunk = std::min<std::streamsize>(rest, egptr() - gptr());
+                std::copy(gptr(), gptr() + chunk, s + done);
+                gbump(static_cast<int>(chunk));
+                done += chunk;
+                continue;
+            }
+            const std::streamsize count_read = m_target->sgetn(s + done, rest);
+            if (count_read <= 0)
+                break;
+            update(s + done, count_read);
+            done += count_read;
+        }
+        return done;
+    }
+private:
+    void update(const char* s, std::streamsize count)
+    {
+        if (count > 0)
+            OSSL_ASSERT(EVP_DigestUpdate(m_md_ctx, s, static_cast<size_t>(count)));
+    }
+    // передать накопленный блок получателю и добавить к хэшу
+    bool flushBlock()
+    {
+        const std::streamsize count = pptr() - pbase();
+        if (count == 0)
+            return true;
+        const std::streamsize written = m_target->sputn(pbase(), count);
+        update(pbase(), written);
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        return written == count;
+    }
+private:
+    std::streambuf* m_target;
+    const EVP_MD* m_md_type;
+    EVP_MD_CTX* m_md_ctx;
+    std::vector<char> m_buffer;
+};
+
 /**
  * Поток, производящий хэширование записанных данных
  */
@@ -0,0 +1,80 @@
+#include "hash_stream.hpp"
+#include <benchmark/benchmark.h>
+#include <openssl/evp.h>
+#include <sstream>
+#include <string>
+
+static void BM_EvpDigest(benchmark::State& state)
+{
+    const std::string data(static_cast<std::size_t>(state.range(0)), 'x');
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int size = 0;
+    for (auto _ : state)
+    {
+        EVP_Digest(data.data(), data.size(), digest, &size, EVP_sha256(), nullptr);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EvpDigest)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+static void BM_HashStreamWrite(benchmark::State& state)
+{
+    const std::string data(static_cast<std::size_t>(state.range(0)), 'x');
+    hash::HashStream stream;
+    for (auto _ : state)
+    {
+        stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+        benchmark::DoNotOptimize(stream.getHash());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashStreamWrite)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+// посимвольная запись через operator<< и overflow
+static void BM_HashStreamPut(benchmark::State& state)
+{
+    const std::string data(static_cast<std::size_t>(state.range(0)), 'x');
+    hash::HashStream stream;
+    for (auto _ : state)
+    {
+        for (char c : data)
+            stream.put(c);
+        benchmark::DoNotOptimize(stream.getHash());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashStreamPut)->RangeMultiplier(16)->Range(64, 1 << 16);
+
+// копирование с хэшированием: запись в получатель, затем второй проход HashStream
+// по тем же байтам без дополнительной копии
+static void BM_CopyThenHash(benchmark::State& state)
+{
+    const std::string data(static_cast<std::size_t>(state.range(0)), 'x');
+    hash::HashStream stream;
+    for (auto _ : state)
+    {
+        std::stringbuf source(data);
+        std::stringbuf destination;
+        std::ostream(&destination) << &source;
+        stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+        benchmark::DoNotOptimize(stream.getHash());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CopyThenHash)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+
+static void BM_CopyThroughTee(benchmark::State& state)
+{
+    const std::string data(static_cast<std::size_t>(state.range(0)), 'x');
+    for (auto _ : state)
+    {
+        std::stringbuf source(data);
+        std::stringbuf destination;
+        hash::TeeHashBuf tee(&source);
+        std::ostream(&destination) << &tee;
+        benchmark::DoNotOptimize(tee.getHash());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CopyThroughTee)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
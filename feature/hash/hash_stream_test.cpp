@@ -77,4 +77,96 @@ TEST_F(OSSLHashFixture, SplitHashStream_Success)
     EXPECT_EQ(SHA256_HASH_OF_ZEROS, (HashStream() << "0" << "00").getHash().toString());
     EXPECT_EQ(SHA256_HASH_OF_ZEROS, (HashStream() << "00" << "0").getHash().toString());
     EXPECT_EQ(SHA256_HASH_OF_ZEROS, (HashStream() << "0" << "0" << "0").getHash().toString());
-}
\ No newline at end of file
+}
+
+static std::string sampleData(size_t size)
+{
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<char>(i * 31 + i / 7);
+    return data;
+}
+
+static std::string referenceHash(const std::string& data)
+{
+    HashStream stream;
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return stream.getHash().toString();
+}
+
+TEST_F(OSSLHashFixture, TeeHashBufWrite_Success)
+{
+    const std::string data = sampleData(1000);
+    std::stringbuf target;
+    TeeHashBuf tee(&target, EVP_sha256(), 16);
+    std::ostream stream(&tee);
+
+    // одиночные символы, запись внутри блока и запись больше блока
+    stream.put(data[0]);
+    stream.write(data.data() + 1, 10);
+    stream.write(data.data() + 11, 100);
+    for (size_t i = 111; i < 120; ++i)
+        stream << data[i];
+    stream.write(data.data() + 120, static_cast<std::streamsize>(data.size() - 120));
+    ASSERT_TRUE(stream.good());
+
+    EXPECT_EQ(referenceHash(data), tee.getHash().toString());
+    EXPECT_EQ(data, target.str());
+}
+
+TEST_F(OSSLHashFixture, TeeHashBufFlush_Success)
+{
+    std::stringbuf target;
+    TeeHashBuf tee(&target);
+    std::ostream stream(&tee);
+    stream << "000";
+    EXPECT_EQ("", target.str());
+    stream.flush();
+    EXPECT_EQ("000", target.str());
+    EXPECT_EQ(SHA256_HASH_OF_ZEROS, tee.getHash().toString());
+
+    stream << "111";
+    EXPECT_EQ(SHA256_HASH_OF_ONES, tee.getHash().toString());
+    EXPECT_EQ("000111", target.str());
+    EXPECT_EQ(SHA256_EMPTY_HASH, tee.getHash().toString());
+}
+
+TEST_F(OSSLHashFixture, TeeHashBufRead_Success)
+{
+    const std::string data = sampleData(1000);
+    std::stringbuf source(data);
+    TeeHashBuf tee(&source, EVP_sha256(), 16);
+    std::istream stream(&tee);
+
+    std::string result(data.size(), '\0');
+    result[0] = static_cast<char>(stream.get());
+    stream.read(&result[1], 10);
+    stream.read(&result[11], 100);
+    stream.read(&result[111], static_cast<std::streamsize>(data.size() - 111));
+    EXPECT_EQ(static_cast<std::streamsize>(data.size() - 111), stream.gcount());
+    EXPECT_EQ(std::char_traits<char>::eof(), stream.get());
+
+    EXPECT_EQ(data, result);
+    EXPECT_EQ(referenceHash(data), tee.getHash().toString());
+}
+
+TEST_F(OSSLHashFixture, TeeHashBufCopy_Success)
+{
+    const std::string data = sampleData(300000);
+    std::stringbuf source(data);
+    std::stringbuf destination;
+    TeeHashBuf tee(&source);
+    std::ostream(&destination) << &tee;
+
+    EXPECT_EQ(data, destination.str());
+    EXPECT_EQ(referenceHash(data), tee.getHash().toString());
+}
+
+TEST_F(OSSLHashFixture, TeeHashBufEmpty_Success)
+{
+    std::stringbuf source;
+    TeeHashBuf tee(&source);
+    std::istream stream(&tee);
+    EXPECT_EQ(std::char_traits<char>::eof(), stream.get());
+    EXPECT_EQ(SHA256_EMPTY_HASH, tee.getHash().toString());
+}
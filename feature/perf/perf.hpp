@@ -0,0 +1,271 @@
+#ifndef PERF_HPP
+#define PERF_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace perf
+{
+
+/**
+ * Счётчик тактов процессора
+ * @note Без RDTSC возвращает наносекунды монотонных часов
+ */
+inline std::uint64_t ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+#endif
+}
+
+/**
+ * Гистограмма с корзинами по степеням двойки
+ * @note Запись без выделения памяти; процентиль - верхняя граница корзины
+ */
+class Histogram
+{
+public:
+    static constexpr std::size_t BUCKETS = 64;
+public:
+    void record(std::uint64_t value)
+    {
+        ++m_buckets[bucket(value)];
+        ++m_count;
+        m_sum += value;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    std::uint64_t count() const
+    {
+        return m_count;
+    }
+    std::uint64_t min() const
+    {
+        return m_count ? m_min : 0;
+    }
+    std::uint64_t max() const
+    {
+        return m_max;
+    }
+    double mean() const
+    {
+        return m_count ? static_cast<double>(m_sum) / static_cast<double>(m_count) : 0.;
+    }
+    /**
+     * Оценка сверху для доли p значений
+     * @param p доля от 0 до 1
+     */
+    std::uint64_t percentile(double p) const
+    {
+        if (m_count == 0)
+            return 0;
+        const double rank = std::clamp(p, 0., 1.) * static_cast<double>(m_count);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i)
+        {
+            seen += m_buckets[i];
+            if (seen > 0 && static_cast<double>(seen) >= rank)
+                return std::min(upperBound(i), m_max);
+        }
+        return m_max;
+    }
+    const std::array<std::uint64_t, BUCKETS>& buckets() const
+    {
+        return m_buckets;
+    }
+    void merge(const Histogram& other)
+    {
+        for (std::size_t i = 0; i < BUCKETS; ++i)
+            m_buckets[i] += other.m_buckets[i];
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+    void clear()
+    {
+        *this = Histogram();
+    }
+private:
+    // корзина i хранит значения с старшим битом i - 1, корзина 0 - только ноль
+    static std::size_t bucket(std::uint64_t value)
+    {
+        std::size_t result = 0;
+        while (value && result < BUCKETS - 1)
+        {
+            value >>= 1;
+            ++result;
+        }
+        return result;
+    }
+    // последняя корзина собирает всё от 2^62 и выше
+    static std::uint64_t upperBound(std::size_t bucket)
+    {
+        return bucket >= BUCKETS - 1 ? std::numeric_limits<std::uint64_t>::max()
+                                     : (std::uint64_t(1) << bucket) - 1;
+    }
+private:
+    std::array<std::uint64_t, BUCKETS> m_buckets{};
+    std::uint64_t m_count = 0;
+    std::uint64_t m_sum = 0;
+    std::uint64_t m_min = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t m_max = 0;
+};
+
+/**
+ * Таймер области видимости: время жизни в наносекундах попадает в гистограмму
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : m_histogram(histogram), m_start(std::chrono::steady_clock::now())
+    {
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+    ~ScopedTimer()
+    {
+        m_histogram.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                 m_start)
+                .count()));
+    }
+private:
+    Histogram& m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Показания аппаратных счётчиков
+ * @note Недоступный счётчик равен нулю, cycles тогда считается через ticks()
+ */
+struct Sample
+{
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t cacheMisses = 0;
+};
+
+/**
+ * Аппаратные счётчики текущего потока через perf_event_open
+ * @note Если ядро или права не позволяют открыть счётчики (контейнер,
+ * perf_event_paranoid), available() ложно и работает только ticks()
+ */
+class Counters
+{
+public:
+    Counters()
+    {
+#if defined(__linux__)
+        m_fds[CYCLES] = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+        if (m_fds[CYCLES] < 0)
+            return;
+        m_fds[INSTRUCTIONS] = open(PERF_COUNT_HW_INSTRUCTIONS, m_fds[CYCLES]);
+        m_fds[CACHE_MISSES] = open(PERF_COUNT_HW_CACHE_MISSES, m_fds[CYCLES]);
+#endif
+    }
+    Counters(const Counters&) = delete;
+    Counters& operator=(const Counters&) = delete;
+    ~Counters()
+    {
+#if defined(__linux__)
+        for (int fd : m_fds)
+        {
+            if (fd >= 0)
+                close(fd);
+        }
+#endif
+    }
+    bool available() const
+    {
+        return m_fds[CYCLES] >= 0;
+    }
+    void start()
+    {
+#if defined(__linux__)
+        if (available())
+        {
+            ioctl(m_fds[CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(m_fds[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+        m_start = ticks();
+    }
+    /**
+     * Остановить счёт и вернуть показания с момента start()
+     */
+    Sample stop()
+    {
+        Sample result;
+        const std::uint64_t end = ticks();
+#if defined(__linux__)
+        if (available())
+        {
+            ioctl(m_fds[CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            result.cycles = read(m_fds[CYCLES]);
+            result.instructions = read(m_fds[INSTRUCTIONS]);
+            result.cacheMisses = read(m_fds[CACHE_MISSES]);
+            return result;
+        }
+#endif
+        result.cycles = end - m_start;
+        return result;
+    }
+private:
+    enum Event
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        CACHE_MISSES,
+        EVENTS
+    };
+#if defined(__linux__)
+    static int open(std::uint64_t config, int group)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = group < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+    }
+    static std::uint64_t read(int fd)
+    {
+        std::uint64_t value = 0;
+        if (fd < 0 || ::read(fd, &value, sizeof(value)) != sizeof(value))
+            return 0;
+        return value;
+    }
+#endif
+private:
+    std::array<int, EVENTS> m_fds{-1, -1, -1};
+    std::uint64_t m_start = 0;
+};
+
+} // namespace perf
+
+#endif // PERF_HPP
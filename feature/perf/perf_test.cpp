@@ -0,0 +1,77 @@
+#include "perf.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(PerfTest, HistogramEmpty)
+{
+    perf::Histogram histogram;
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0u, histogram.min());
+    EXPECT_EQ(0u, histogram.max());
+    EXPECT_EQ(0., histogram.mean());
+    EXPECT_EQ(0u, histogram.percentile(0.5));
+}
+
+TEST(PerfTest, HistogramBuckets)
+{
+    perf::Histogram histogram;
+    for (std::uint64_t value : {0, 1, 2, 3, 4, 1000})
+        histogram.record(value);
+    EXPECT_EQ(6u, histogram.count());
+    EXPECT_EQ(0u, histogram.min());
+    EXPECT_EQ(1000u, histogram.max());
+    EXPECT_DOUBLE_EQ(1010. / 6, histogram.mean());
+
+    EXPECT_EQ(1u, histogram.buckets()[0]);
+    EXPECT_EQ(1u, histogram.buckets()[1]);
+    EXPECT_EQ(2u, histogram.buckets()[2]);
+    EXPECT_EQ(1u, histogram.buckets()[3]);
+    EXPECT_EQ(1u, histogram.buckets()[10]);
+
+    EXPECT_EQ(3u, histogram.percentile(0.5));
+    EXPECT_EQ(1000u, histogram.percentile(1.));
+    EXPECT_EQ(0u, histogram.percentile(0.));
+}
+
+TEST(PerfTest, HistogramMerge)
+{
+    perf::Histogram first;
+    perf::Histogram second;
+    first.record(10);
+    second.record(std::numeric_limits<std::uint64_t>::max());
+    first.merge(second);
+    EXPECT_EQ(2u, first.count());
+    EXPECT_EQ(10u, first.min());
+    EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), first.max());
+    EXPECT_EQ(1u, first.buckets()[perf::Histogram::BUCKETS - 1]);
+    EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), first.percentile(1.));
+
+    first.clear();
+    EXPECT_EQ(0u, first.count());
+}
+
+TEST(PerfTest, ScopedTimer)
+{
+    perf::Histogram histogram;
+    {
+        perf::ScopedTimer timer(histogram);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    ASSERT_EQ(1u, histogram.count());
+    EXPECT_GE(histogram.min(), 2000000u);
+}
+
+TEST(PerfTest, CountersFallback)
+{
+    perf::Counters counters;
+    counters.start();
+    volatile std::uint64_t sum = 0;
+    for (int i = 0; i < 100000; ++i)
+        sum = sum + static_cast<std::uint64_t>(i);
+    const perf::Sample sample = counters.stop();
+    EXPECT_GT(sample.cycles, 0u);
+    if (counters.available())
+        EXPECT_GT(sample.instructions, 0u);
+    else
+        EXPECT_EQ(0u, sample.instructions);
+}
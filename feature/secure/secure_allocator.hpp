@@ -1,8 +1,25 @@
 #ifndef SECURE_ALLOCATOR_HPP
 #define SECURE_ALLOCATOR_HPP
 
+#include "secure_memory.hpp"
+#if defined(SECURE_ALLOCATOR_STATS) || defined(SECURE_ALLOCATOR_LEAK_CHECK)
+#include "secure_allocator_stats.hpp"
+#define SECURE_ALLOCATOR_INSTRUMENTED
+#endif
+
+// Аллокатор с инструментацией и без неё - разные определения, поэтому каждая конфигурация
+// макросов получает своё встроенное пространство имён. В него же помещается каждый тип,
+// который использует аллокатор во встроенных функциях (см. secure_string.hpp): единицы
+// трансляции с разными настройками получают разные символы вместо одного с расходящимися
+// определениями (ODR)
+#if defined(SECURE_ALLOCATOR_LEAK_CHECK)
+#define SECURE_ALLOCATOR_ABI leak_checked
+#elif defined(SECURE_ALLOCATOR_INSTRUMENTED)
+#define SECURE_ALLOCATOR_ABI instrumented
+#else
+#define SECURE_ALLOCATOR_ABI plain
+#endif
 #include <cstddef>
-#include <cstring>
 #include <limits>
 #include <new>
 #include <type_traits>
@@ -11,6 +28,16 @@
 namespace secure
 {
 
+inline namespace SECURE_ALLOCATOR_ABI
+{
+
+/**
+ * Аллокатор, обнуляющий память при освобождении
+ * @attention Обнуление выполняется только в deallocate, целым блоком. destroy() память
+ * не трогает, поэтому после clear(), pop_back() или уменьшающего resize() освободившиеся
+ * ячейки контейнера хранят прежние байты, пока блок не будет освобождён или перезаписан.
+ * Контейнер, переиспользующий ёмкость под секреты, обнуляет её сам, как SecureString
+ */
 template <class T>
 class SecureAllocator
 {
@@ -45,13 +72,20 @@ public:
     {
         if (n > std::numeric_limits<size_type>::max() / sizeof(T))
             throw std::bad_alloc();
-        return static_cast<pointer>(::operator new(n * sizeof(T)));
+        pointer p = static_cast<pointer>(::operator new(n * sizeof(T)));
+#if defined(SECURE_ALLOCATOR_INSTRUMENTED)
+        stats::onAllocate(p, n * sizeof(T));
+#endif
+        return p;
     }
     void deallocate(pointer p, size_type n) noexcept
     {
         if (!p)
             return;
-        clear(p, n * sizeof(T));
+#if defined(SECURE_ALLOCATOR_INSTRUMENTED)
+        stats::onDeallocate(p, n * sizeof(T));
+#endif
+        secureZero(p, n * sizeof(T));
         ::operator delete(p);
     }
 public:
@@ -60,22 +94,13 @@ public:
     {
         ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
     }
+    // без обнуления, см. описание класса
     template <class U>
     void destroy(U* p) noexcept
     {
         if (!p)
             return;
         p->~U();
-        clear(static_cast<void*>(p), sizeof(U));
-    }
-private:
-    inline void clear(void* p, std::size_t n)
-    {
-        volatile unsigned char* vp = static_cast<volatile unsigned char*>(p);
-        while (n--)
-        {
-            *vp++ = 0;
-        }
     }
 };
 
@@ -90,6 +115,8 @@ inline bool operator!=(const SecureAllocator<T>&, const SecureAllocator<U>&) noe
     return false;
 }
 
+} // namespace SECURE_ALLOCATOR_ABI
+
 } // namespace secure
 
 #endif // SECURE_ALLOCATOR_HPP
\ No newline at end of file
@@ -0,0 +1,265 @@
+#ifndef SECURE_ALLOCATOR_STATS_HPP
+#define SECURE_ALLOCATOR_STATS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * Инструментация SecureAllocator, включается макросами:
+ * SECURE_ALLOCATOR_STATS - счётчики выделений и гистограмма размеров
+ * SECURE_ALLOCATOR_LEAK_CHECK - учёт живых блоков и отчёт о неосвобождённых при завершении
+ * Без макросов аллокатор не обращается к этому заголовку
+ * @note Раскладка Registry и встроенные функции зависят от SECURE_ALLOCATOR_LEAK_CHECK,
+ * поэтому каждый вариант живёт в своём встроенном пространстве имён
+ */
+
+namespace secure
+{
+
+namespace stats
+{
+
+#if defined(SECURE_ALLOCATOR_LEAK_CHECK)
+inline namespace leak_checked
+#else
+inline namespace counted
+#endif
+{
+
+// корзина k содержит размеры из (2^(k-1), 2^k], последняя - всё, что больше
+static const std::size_t HISTOGRAM_SIZE = 24;
+
+/**
+ * Снимок счётчиков аллокатора
+ */
+struct Snapshot
+{
+    std::size_t live_bytes = 0;
+    std::size_t peak_bytes = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t histogram[HISTOGRAM_SIZE] = {};
+};
+
+/**
+ * Неосвобождённый блок
+ */
+struct Leak
+{
+    const void* ptr;
+    std::size_t bytes;
+};
+
+namespace detail
+{
+
+inline std::size_t bucket(std::size_t bytes)
+{
+    std::size_t k = 0;
+    while (k + 1 < HISTOGRAM_SIZE && (static_cast<std::size_t>(1) << k) < bytes)
+        ++k;
+    return k;
+}
+
+// счётчики одного потока, пишет только поток-владелец
+struct ThreadCounters
+{
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> deallocations{0};
+    std::atomic<std::uint64_t> histogram[HISTOGRAM_SIZE] = {};
+};
+
+inline void increment(std::atomic<std::uint64_t>& counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+class Registry
+{
+public:
+    static Registry& instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+    void attach(ThreadCounters* counters)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.push_back(counters);
+    }
+    // счётчики завершившегося потока переносятся в общий итог
+    void detach(ThreadCounters* counters)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.erase(std::remove(m_threads.begin(), m_threads.end(), counters),
+                        m_threads.end());
+        merge(m_retired, *counters);
+    }
+    void onAllocate(std::size_t bytes)
+    {
+        const std::size_t live = m_live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::size_t peak = m_peak.load(std::memory_order_relaxed);
+        while (peak < live &&
+               !m_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+    void onDeallocate(std::size_t bytes)
+    {
+        m_live.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+    Snapshot snapshot()
+    {
+        Snapshot result;
+        result.live_bytes = m_live.load(std::memory_order_relaxed);
+        result.peak_bytes = m_peak.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        add(result, m_retired);
+        for (const ThreadCounters* counters : m_threads)
+            add(result, *counters);
+        return result;
+    }
+#if defined(SECURE_ALLOCATOR_LEAK_CHECK)
+    void track(const void* p, std::size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocks[p] = bytes;
+    }
+    void untrack(const void* p)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocks.erase(p);
+    }
+    std::vector<Leak> leaks()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<Leak> result;
+        result.reserve(m_blocks.size());
+        for (const auto& block : m_blocks)
+            result.push_back(Leak{block.first, block.second});
+        return result;
+    }
+#endif
+private:
+    Registry() = default;
+    ~Registry()
+    {
+#if defined(SECURE_ALLOCATOR_LEAK_CHECK)
+        for (const auto& block : m_blocks)
+        {
+            std::fprintf(stderr, "SecureAllocator: block %p of %zu bytes was never freed\n",
+                         block.first, block.second);
+        }
+#endif
+    }
+    static void merge(ThreadCounters& to, const ThreadCounters& from)
+    {
+        to.allocations += from.allocations.load(std::memory_order_relaxed);
+        to.deallocations += from.deallocations.load(std::memory_order_relaxed);
+        for (std::size_t k = 0; k < HISTOGRAM_SIZE; ++k)
+            to.histogram[k] += from.histogram[k].load(std::memory_order_relaxed);
+    }
+    static void add(Snapshot& to, const ThreadCounters& from)
+    {
+        to.allocations += from.allocations.load(std::memory_order_relaxed);
+        to.deallocations += from.deallocations.load(std::memory_order_relaxed);
+        for (std::size_t k = 0; k < HISTOGRAM_SIZE; ++k)
+            to.histogram[k] += from.histogram[k].load(std::memory_order_relaxed);
+    }
+private:
+    std::mutex m_mutex;
+    std::vector<ThreadCounters*> m_threads;
+    ThreadCounters m_retired;
+    // пик требует общего представления, поэтому объём живой памяти - общий счётчик
+    std::atomic<std::size_t> m_live{0};
+    std::atomic<std::size_t> m_peak{0};
+#if defined(SECURE_ALLOCATOR_LEAK_CHECK)
+    std::map<const void*, std::size_t> m_blocks;
+#endif
+};
+
+// регистрирует счётчики потока на время его жизни
+class ThreadSlot
+{
+public:
+    ThreadSlot() : m_registry(Registry::instance())
+    {
+        m_registry.attach(&m_counters);
+    }
+    ~ThreadSlot()
+    {
+        m_registry.detach(&m_counters);
+    }
+    ThreadCounters& counters()
+    {
+        return m_counters;
+    }
+private:
+    Registry& m_registry;
+    ThreadCounters m_counters;
+};
+
+inline ThreadCounters& threadCounters()
+{
+    static thread_local ThreadSlot slot;
+    return slot.counters();
+}
+
+} // namespace detail
+
+inline void onAllocate(const void* p, std::size_t bytes)
+{
+    detail::ThreadCounters& counters = detail::threadCounters();
+    detail::increment(counters.allocations);
+    detail::increment(counters.histogram[detail::bucket(bytes)]);
+    detail::Registry::instance().onAllocate(bytes);
+#if defined(SECURE_ALLOCATOR_LEAK_CHECK)
+    detail::Registry::instance().track(p, bytes);
+#else
+    (void)p;
+#endif
+}
+
+inline void onDeallocate(const void* p, std::size_t bytes)
+{
+    detail::increment(detail::threadCounters().deallocations);
+    detail::Registry::instance().onDeallocate(bytes);
+#if defined(SECURE_ALLOCATOR_LEAK_CHECK)
+    detail::Registry::instance().untrack(p);
+#else
+    (void)p;
+#endif
+}
+
+/**
+ * Получить сумму счётчиков всех потоков
+ */
+inline Snapshot snapshot()
+{
+    return detail::Registry::instance().snapshot();
+}
+
+#if defined(SECURE_ALLOCATOR_LEAK_CHECK)
+/**
+ * Получить блоки, которые ещё не освобождены
+ */
+inline std::vector<Leak> leaks()
+{
+    return detail::Registry::instance().leaks();
+}
+#endif
+
+} // inline namespace
+
+} // namespace stats
+
+} // namespace secure
+
+#endif // SECURE_ALLOCATOR_STATS_HPP
@@ -0,0 +1,73 @@
+#include "secure_allocator.hpp"
+#include "secure_string.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <type_traits>
+
+using namespace secure;
+
+// инструментированный аллокатор и строки на нём - отдельные типы, а не другие
+// определения тех же
+static_assert(std::is_same<SecureAllocator<char>, leak_checked::SecureAllocator<char>>::value,
+              "instrumented allocator must live in its own inline namespace");
+static_assert(std::is_same<SecureString, leak_checked::vector_based_string::SecureString>::value,
+              "strings must follow the allocator configuration");
+static_assert(std::is_same<sso_string::SecureString, leak_checked::sso_string::SecureString>::value,
+              "strings must follow the allocator configuration");
+
+TEST(SecureAllocatorStatsTest, CountAllocations)
+{
+    const stats::Snapshot before = stats::snapshot();
+    SecureAllocator<char> allocator;
+    char* p1 = allocator.allocate(100);
+    char* p2 = allocator.allocate(1000);
+    const stats::Snapshot during = stats::snapshot();
+    EXPECT_EQ(during.allocations - before.allocations, 2u);
+    EXPECT_EQ(during.live_bytes - before.live_bytes, 1100u);
+    EXPECT_GE(during.peak_bytes, during.live_bytes);
+    EXPECT_EQ(during.histogram[7] - before.histogram[7], 1u);
+    EXPECT_EQ(during.histogram[10] - before.histogram[10], 1u);
+    allocator.deallocate(p1, 100);
+    allocator.deallocate(p2, 1000);
+    const stats::Snapshot after = stats::snapshot();
+    EXPECT_EQ(after.deallocations - before.deallocations, 2u);
+    EXPECT_EQ(after.live_bytes, before.live_bytes);
+}
+
+TEST(SecureAllocatorStatsTest, AggregateThreads)
+{
+    const stats::Snapshot before = stats::snapshot();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            []()
+            {
+                for (int i = 0; i < 100; ++i)
+                {
+                    SecureString s("a secret long enough to be allocated");
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    const stats::Snapshot after = stats::snapshot();
+    EXPECT_EQ(after.allocations - before.allocations, 400u);
+    EXPECT_EQ(after.deallocations - before.deallocations, 400u);
+    EXPECT_EQ(after.live_bytes, before.live_bytes);
+}
+
+TEST(SecureAllocatorStatsTest, ReportLeaks)
+{
+    const size_t before = stats::leaks().size();
+    SecureAllocator<int> allocator;
+    int* p = allocator.allocate(4);
+    const std::vector<stats::Leak> leaks = stats::leaks();
+    ASSERT_EQ(leaks.size(), before + 1);
+    bool found = false;
+    for (const stats::Leak& leak : leaks)
+        found = found || (leak.ptr == p && leak.bytes == 4 * sizeof(int));
+    EXPECT_TRUE(found);
+    allocator.deallocate(p, 4);
+    EXPECT_EQ(stats::leaks().size(), before);
+}
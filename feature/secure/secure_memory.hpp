@@ -0,0 +1,100 @@
+#ifndef SECURE_MEMORY_HPP
+#define SECURE_MEMORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace secure
+{
+
+namespace detail
+{
+
+#if !defined(__GNUC__) && !defined(_WIN32)
+// вызов через volatile указатель не может быть удалён оптимизатором
+using memset_type = void* (*)(void*, int, std::size_t);
+static volatile memset_type volatile_memset = std::memset;
+#endif
+
+} // namespace detail
+
+/**
+ * Обнулить память так, чтобы компилятор не смог удалить запись
+ * @note Обнуление выполняется memset'ом на всю ширину слова/SIMD регистра,
+ * после чего барьер сообщает компилятору, что память могла быть прочитана
+ */
+inline void secureZero(void* p, std::size_t n) noexcept
+{
+    if (!p || n == 0)
+        return;
+#if defined(__GNUC__)
+    std::memset(p, 0, n);
+    __asm__ __volatile__("" : : "r"(p) : "memory");
+#elif defined(_WIN32)
+    SecureZeroMemory(p, n);
+#else
+    detail::volatile_memset(p, 0, n);
+#endif
+}
+
+/**
+ * Сравнить блоки памяти за время, зависящее только от n
+ * @note Сравнение идёт словами по 8 байт без раннего выхода
+ */
+inline bool secureEqual(const void* a, const void* b, std::size_t n) noexcept
+{
+    const unsigned char* pa = static_cast<const unsigned char*>(a);
+    const unsigned char* pb = static_cast<const unsigned char*>(b);
+    std::uint64_t diff = 0;
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= n; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t wa, wb;
+        std::memcpy(&wa, pa + i, sizeof(wa));
+        std::memcpy(&wb, pb + i, sizeof(wb));
+        diff |= wa ^ wb;
+    }
+    for (; i < n; ++i)
+    {
+        diff |= static_cast<std::uint64_t>(pa[i] ^ pb[i]);
+    }
+#if defined(__GNUC__)
+    __asm__ __volatile__("" : "+r"(diff));
+#endif
+    return diff == 0;
+}
+
+/**
+ * Сравнить секрет с входными данными, не раскрывая длину секрета
+ * @note Время зависит только от input_len, которую и так знает вызывающая сторона.
+ * Сравнение побайтное: позиция в секрете маскируется для каждого байта отдельно,
+ * а словное чтение на границе секрета потребовало бы ветвления по secret_len
+ * или чтения за его пределами
+ */
+inline bool secureEqual(const void* secret, std::size_t secret_len, const void* input,
+                        std::size_t input_len) noexcept
+{
+    static const unsigned char empty = 0;
+    const unsigned char* ps = secret_len ? static_cast<const unsigned char*>(secret) : &empty;
+    const unsigned char* pi = static_cast<const unsigned char*>(input);
+    std::size_t diff = secret_len ^ input_len;
+    for (std::size_t i = 0; i < input_len; ++i)
+    {
+        // за пределами секрета читаем его первый байт, сохраняя шаблон доступа
+        const std::size_t inside = 0 - static_cast<std::size_t>(i < secret_len);
+        diff |= static_cast<std::size_t>(ps[i & inside] ^ pi[i]);
+    }
+#if defined(__GNUC__)
+    __asm__ __volatile__("" : "+r"(diff));
+#endif
+    return diff == 0;
+}
+
+} // namespace secure
+
+#endif // SECURE_MEMORY_HPP
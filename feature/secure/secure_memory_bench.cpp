@@ -0,0 +1,89 @@
+#include "secure_allocator.hpp"
+#include "secure_memory.hpp"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+// побайтовое обнуление через volatile, использовавшееся ранее
+static void volatileZero(void* p, std::size_t n)
+{
+    volatile unsigned char* vp = static_cast<volatile unsigned char*>(p);
+    while (n--)
+    {
+        *vp++ = 0;
+    }
+}
+
+static void BM_VolatileZero(benchmark::State& state)
+{
+    std::vector<unsigned char> buffer(static_cast<std::size_t>(state.range(0)), 0xFF);
+    for (auto _ : state)
+    {
+        volatileZero(buffer.data(), buffer.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VolatileZero)->RangeMultiplier(8)->Range(64, 64 << 10);
+
+static void BM_SecureZero(benchmark::State& state)
+{
+    std::vector<unsigned char> buffer(static_cast<std::size_t>(state.range(0)), 0xFF);
+    for (auto _ : state)
+    {
+        secure::secureZero(buffer.data(), buffer.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SecureZero)->RangeMultiplier(8)->Range(64, 64 << 10);
+
+static void BM_SecureAllocatorRoundTrip(benchmark::State& state)
+{
+    secure::SecureAllocator<char> allocator;
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        char* p = allocator.allocate(size);
+        benchmark::DoNotOptimize(p);
+        allocator.deallocate(p, size);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SecureAllocatorRoundTrip)->RangeMultiplier(8)->Range(64, 64 << 10);
+
+static void BM_Memcmp(benchmark::State& state)
+{
+    std::vector<unsigned char> a(static_cast<std::size_t>(state.range(0)), 0x5A);
+    std::vector<unsigned char> b(a);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::memcmp(a.data(), b.data(), a.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Memcmp)->RangeMultiplier(8)->Range(16, 4 << 10);
+
+static void BM_SecureEqual(benchmark::State& state)
+{
+    std::vector<unsigned char> a(static_cast<std::size_t>(state.range(0)), 0x5A);
+    std::vector<unsigned char> b(a);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(secure::secureEqual(a.data(), b.data(), a.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SecureEqual)->RangeMultiplier(8)->Range(16, 4 << 10);
+
+static void BM_SecureEqualLengthHiding(benchmark::State& state)
+{
+    std::vector<unsigned char> a(static_cast<std::size_t>(state.range(0)), 0x5A);
+    std::vector<unsigned char> b(a);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(secure::secureEqual(a.data(), a.size(), b.data(), b.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SecureEqualLengthHiding)->RangeMultiplier(8)->Range(16, 4 << 10);
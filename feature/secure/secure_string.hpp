@@ -2,16 +2,25 @@
 #define SECURE_STRING_H
 
 #include "secure_allocator.hpp"
+#include "secure_memory.hpp"
+#include <algorithm>
 #include <cstring>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace secure
 {
 
+// строки вызывают SecureAllocator во встроенных функциях и меняются вместе с ним
+inline namespace SECURE_ALLOCATOR_ABI
+{
+
 namespace secure_allocator_string
 {
-// @attention Small String Optimization
+// @attention Small String Optimization: короткая строка хранится во внутреннем буфере
+// std::string в обход аллокатора и не обнуляется, см. sso_string::SecureString
 using SecureString = std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>;
 } // namespace secure_allocator_string
 
@@ -31,9 +40,13 @@ public:
     {
         assign(s);
     }
+    SecureString(const char* s, size_type len)
+    {
+        assign(s, len);
+    }
     SecureString(const SecureString& other)
     {
-        assign(other.c_str());
+        assign(other.c_str(), other.size());
     }
     SecureString(SecureString&& other) : m_buffer(std::move(other.m_buffer))
     {
@@ -42,7 +55,7 @@ public:
     SecureString& operator=(const SecureString& other)
     {
         if (this != &other)
-            assign(other.c_str());
+            assign(other.c_str(), other.size());
         return *this;
     }
     SecureString& operator=(SecureString&& other)
@@ -54,31 +67,56 @@ public:
         }
         return *this;
     }
-    ~SecureString()
-    {
-        clear();
-    }
+    // буфер обнуляется аллокатором при освобождении
+    ~SecureString() = default;
 public:
     void assign(const char* s)
     {
+        assign(s, std::strlen(s));
+    }
+    /**
+     * Заменить содержимое, переиспользуя выделенную память
+     */
+    void assign(const char* s, size_type len)
+    {
+        if (aliases(s))
+        {
+            // s указывает внутрь собственного буфера
+            std::memmove(m_buffer.data(), s, len);
+            truncate(len);
+            return;
+        }
         clear();
-        size_t len = std::strlen(s);
-        m_buffer.resize(len + 1);
-        std::memcpy(m_buffer.data(), s, len);
-        m_buffer[len] = '\0';
+        append(s, len);
+    }
+    template <typename StringView>
+    auto assign(const StringView& sv) -> decltype(sv.data(), sv.size(), void())
+    {
+        assign(sv.data(), sv.size());
     }
     void clear()
     {
         if (!m_buffer.empty())
         {
-            volatile char* p = m_buffer.data();
-            for (size_type i = 0; i < m_buffer.size(); ++i)
-            {
-                p[i] = 0;
-            }
+            secureZero(m_buffer.data(), m_buffer.size());
             m_buffer.clear();
         }
     }
+    /**
+     * Зарезервировать память под len символов
+     * @note Старый блок обнуляется аллокатором при переносе
+     */
+    void reserve(size_type len)
+    {
+        if (len >= m_buffer.max_size())
+            throw std::length_error("secure string is too long");
+        if (len + 1 > m_buffer.capacity())
+            m_buffer.reserve(len + 1);
+    }
+    size_type capacity() const
+    {
+        return m_buffer.capacity() == 0 ? 0 : m_buffer.capacity() - 1;
+    }
     size_type size() const
     {
         return m_buffer.empty() ? 0 : m_buffer.size() - 1;
@@ -87,16 +125,55 @@ public:
     {
         return m_buffer.empty() ? "" : m_buffer.data();
     }
+    const char* data() const
+    {
+        return c_str();
+    }
     void append(const char* s)
     {
-        size_t len = std::strlen(s);
+        append(s, std::strlen(s));
+    }
+    /**
+     * Дописать len символов
+     * @note Ёмкость растёт геометрически, поэтому посимвольная сборка линейна
+     */
+    void append(const char* s, size_type len)
+    {
         if (len == 0)
             return;
-        size_type old_size = m_buffer.empty() ? 0 : m_buffer.size() - 1;
+        const size_type old_size = size();
+        // место под завершающий ноль: old_size + len + 1 не должно переполниться
+        if (len >= m_buffer.max_size() - old_size)
+            throw std::length_error("secure string is too long");
+        if (old_size + len > capacity())
+        {
+            const size_type growth =
+                std::max(old_size + len, std::min(2 * capacity(), m_buffer.max_size() - 1));
+            if (aliases(s))
+            {
+                const size_type offset = s - m_buffer.data();
+                reserve(growth);
+                s = m_buffer.data() + offset;
+            }
+            else
+            {
+                reserve(growth);
+            }
+        }
+        // ёмкости достаточно, resize не переносит буфер
         m_buffer.resize(old_size + len + 1);
-        std::memcpy(m_buffer.data() + old_size, s, len);
+        std::memmove(m_buffer.data() + old_size, s, len);
         m_buffer.back() = '\0';
     }
+    void append(const SecureString& other)
+    {
+        append(other.c_str(), other.size());
+    }
+    template <typename StringView>
+    auto append(const StringView& sv) -> decltype(sv.data(), sv.size(), void())
+    {
+        append(sv.data(), sv.size());
+    }
     bool empty() const
     {
         return size() == 0;
@@ -114,11 +191,18 @@ public:
     {
         return m_buffer[idx];
     }
+    /**
+     * Сравнить за время, зависящее только от len
+     */
+    bool equals(const char* s, size_type len) const
+    {
+        return secureEqual(c_str(), size(), s, len);
+    }
     friend bool operator==(const SecureString& lhs, const SecureString& rhs)
     {
         if (lhs.size() != rhs.size())
             return false;
-        return std::memcmp(lhs.c_str(), rhs.c_str(), lhs.size()) == 0;
+        return secureEqual(lhs.c_str(), rhs.c_str(), lhs.size());
     }
     friend bool operator!=(const SecureString& lhs, const SecureString& rhs)
     {
@@ -126,7 +210,7 @@ public:
     }
     friend bool operator==(const SecureString& lhs, const char* rhs)
     {
-        return std::strcmp(lhs.c_str(), rhs) == 0;
+        return lhs.equals(rhs, std::strlen(rhs));
     }
     friend bool operator==(const char* lhs, const SecureString& rhs)
     {
@@ -140,12 +224,306 @@ public:
     {
         return !(lhs == rhs);
     }
+private:
+    bool aliases(const char* s) const
+    {
+        return !m_buffer.empty() && s >= m_buffer.data() && s < m_buffer.data() + m_buffer.size();
+    }
+    // укоротить строку до len символов, обнулив хвост
+    void truncate(size_type len)
+    {
+        secureZero(m_buffer.data() + len, m_buffer.size() - len);
+        m_buffer.resize(len + 1);
+    }
 private:
     container_type m_buffer;
 };
 
 } // namespace vector_based_string
 
+namespace sso_string
+{
+
+/**
+ * Строка с обнуляемым внутренним буфером для коротких секретов
+ * @note Строки до inline_capacity() символов хранятся внутри объекта без выделения памяти,
+ * более длинные размещаются через SecureAllocator
+ */
+class SecureString
+{
+public:
+    using value_type = char;
+    using allocator_type = SecureAllocator<value_type>;
+    using size_type = std::size_t;
+public:
+    static constexpr size_type inline_capacity()
+    {
+        return INLINE_SIZE - 1;
+    }
+    /**
+     * Максимальная длина с учётом завершающего нуля
+     */
+    static size_type max_size() noexcept
+    {
+        return std::allocator_traits<allocator_type>::max_size(allocator_type()) - 1;
+    }
+public:
+    SecureString() noexcept : m_data(m_inline), m_size(0), m_capacity(inline_capacity())
+    {
+        m_inline[0] = '\0';
+    }
+    SecureString(const char* s) : SecureString()
+    {
+        assign(s);
+    }
+    SecureString(const char* s, size_type len) : SecureString()
+    {
+        assign(s, len);
+    }
+    SecureString(const SecureString& other) : SecureString()
+    {
+        assign(other.c_str(), other.size());
+    }
+    SecureString(SecureString&& other) noexcept : SecureString()
+    {
+        steal(other);
+    }
+    SecureString& operator=(const SecureString& other)
+    {
+        if (this != &other)
+            assign(other.c_str(), other.size());
+        return *this;
+    }
+    SecureString& operator=(SecureString&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+    ~SecureString()
+    {
+        release();
+    }
+public:
+    void assign(const char* s)
+    {
+        assign(s, std::strlen(s));
+    }
+    /**
+     * Заменить содержимое, переиспользуя выделенную память
+     */
+    void assign(const char* s, size_type len)
+    {
+        if (aliases(s))
+        {
+            // s указывает внутрь собственного буфера
+            std::memmove(m_data, s, len);
+            truncate(len);
+            return;
+        }
+        clear();
+        append(s, len);
+    }
+    template <typename StringView>
+    auto assign(const StringView& sv) -> decltype(sv.data(), sv.size(), void())
+    {
+        assign(sv.data(), sv.size());
+    }
+    void clear() noexcept
+    {
+        truncate(0);
+    }
+    /**
+     * Зарезервировать память под len символов
+     * @note Старый буфер обнуляется при переносе
+     */
+    void reserve(size_type len)
+    {
+        if (len <= m_capacity)
+            return;
+        if (len > max_size())
+            throw std::length_error("secure string is too long");
+        char* data = allocator_type().allocate(len + 1);
+        std::memcpy(data, m_data, m_size + 1);
+        const size_type size = m_size;
+        release();
+        m_data = data;
+        m_size = size;
+        m_capacity = len;
+    }
+    size_type capacity() const
+    {
+        return m_capacity;
+    }
+    size_type size() const
+    {
+        return m_size;
+    }
+    const char* c_str() const
+    {
+        return m_data;
+    }
+    const char* data() const
+    {
+        return m_data;
+    }
+    void append(const char* s)
+    {
+        append(s, std::strlen(s));
+    }
+    /**
+     * Дописать len символов
+     * @note Ёмкость растёт геометрически, поэтому посимвольная сборка линейна
+     */
+    void append(const char* s, size_type len)
+    {
+        if (len == 0)
+            return;
+        if (len > max_size() - m_size)
+            throw std::length_error("secure string is too long");
+        if (m_size + len > m_capacity)
+        {
+            const size_type doubled =
+                m_capacity > max_size() / 2 ? max_size() : 2 * m_capacity;
+            const size_type growth = std::max(m_size + len, doubled);
+            if (aliases(s))
+            {
+                const size_type offset = s - m_data;
+                reserve(growth);
+                s = m_data + offset;
+            }
+            else
+            {
+                reserve(growth);
+            }
+        }
+        std::memmove(m_data + m_size, s, len);
+        m_size += len;
+        m_data[m_size] = '\0';
+    }
+    void append(const SecureString& other)
+    {
+        append(other.c_str(), other.size());
+    }
+    template <typename StringView>
+    auto append(const StringView& sv) -> decltype(sv.data(), sv.size(), void())
+    {
+        append(sv.data(), sv.size());
+    }
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+    void swap(SecureString& other) noexcept
+    {
+        SecureString temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+public:
+    char& operator[](size_type idx)
+    {
+        return m_data[idx];
+    }
+    const char& operator[](size_type idx) const
+    {
+        return m_data[idx];
+    }
+    /**
+     * Сравнить за время, зависящее только от len
+     */
+    bool equals(const char* s, size_type len) const
+    {
+        return secureEqual(m_data, m_size, s, len);
+    }
+    friend bool operator==(const SecureString& lhs, const SecureString& rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        return secureEqual(lhs.c_str(), rhs.c_str(), lhs.size());
+    }
+    friend bool operator!=(const SecureString& lhs, const SecureString& rhs)
+    {
+        return !(lhs == rhs);
+    }
+    friend bool operator==(const SecureString& lhs, const char* rhs)
+    {
+        return lhs.equals(rhs, std::strlen(rhs));
+    }
+    friend bool operator==(const char* lhs, const SecureString& rhs)
+    {
+        return rhs == lhs;
+    }
+    friend bool operator!=(const SecureString& lhs, const char* rhs)
+    {
+        return !(lhs == rhs);
+    }
+    friend bool operator!=(const char* lhs, const SecureString& rhs)
+    {
+        return !(lhs == rhs);
+    }
+private:
+    bool isInline() const
+    {
+        return m_data == m_inline;
+    }
+    bool aliases(const char* s) const
+    {
+        return s >= m_data && s < m_data + m_size;
+    }
+    // укоротить строку до len символов, обнулив хвост
+    void truncate(size_type len) noexcept
+    {
+        secureZero(m_data + len, m_size - len);
+        m_size = len;
+        m_data[len] = '\0';
+    }
+    // освободить буфер, обнулив его, и вернуться к внутреннему хранению
+    void release() noexcept
+    {
+        if (isInline())
+            secureZero(m_inline, m_size);
+        else
+            allocator_type().deallocate(m_data, m_capacity + 1);
+        m_data = m_inline;
+        m_size = 0;
+        m_capacity = inline_capacity();
+        m_inline[0] = '\0';
+    }
+    // забрать содержимое other, оставив его пустым и обнулённым
+    void steal(SecureString& other) noexcept
+    {
+        if (other.isInline())
+        {
+            std::memcpy(m_inline, other.m_inline, other.m_size + 1);
+            m_size = other.m_size;
+            other.clear();
+            return;
+        }
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        other.m_data = other.m_inline;
+        other.m_size = 0;
+        other.m_capacity = inline_capacity();
+        other.m_inline[0] = '\0';
+    }
+private:
+    static const size_type INLINE_SIZE = 24;
+private:
+    char* m_data;
+    size_type m_size;
+    size_type m_capacity;
+    char m_inline[INLINE_SIZE];
+};
+
+} // namespace sso_string
+
+} // namespace SECURE_ALLOCATOR_ABI
+
 } // namespace secure
 
 #endif // SECURE_STRING_H
\ No newline at end of file
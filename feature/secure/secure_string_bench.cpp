@@ -0,0 +1,48 @@
+#include "secure_string.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+
+template <typename String>
+static void BM_Create(benchmark::State& state)
+{
+    const std::string text(static_cast<std::size_t>(state.range(0)), 'x');
+    for (auto _ : state)
+    {
+        String s(text.c_str(), text.size());
+        benchmark::DoNotOptimize(s.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Create<std::string>)->Arg(8)->Arg(23)->Arg(256);
+BENCHMARK(BM_Create<secure::vector_based_string::SecureString>)->Arg(8)->Arg(23)->Arg(256);
+BENCHMARK(BM_Create<secure::sso_string::SecureString>)->Arg(8)->Arg(23)->Arg(256);
+
+template <typename String>
+static void BM_AppendChars(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        String s;
+        for (int64_t i = 0; i < state.range(0); ++i)
+            s.append("x", 1);
+        benchmark::DoNotOptimize(s.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AppendChars<std::string>)->Arg(16)->Arg(1024);
+BENCHMARK(BM_AppendChars<secure::vector_based_string::SecureString>)->Arg(16)->Arg(1024);
+BENCHMARK(BM_AppendChars<secure::sso_string::SecureString>)->Arg(16)->Arg(1024);
+
+template <typename String>
+static void BM_Equals(benchmark::State& state)
+{
+    const std::string text(static_cast<std::size_t>(state.range(0)), 'x');
+    const String lhs(text.c_str(), text.size());
+    const String rhs(text.c_str(), text.size());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(lhs == rhs);
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Equals<std::string>)->Arg(16)->Arg(1024);
+BENCHMARK(BM_Equals<secure::vector_based_string::SecureString>)->Arg(16)->Arg(1024);
+BENCHMARK(BM_Equals<secure::sso_string::SecureString>)->Arg(16)->Arg(1024);
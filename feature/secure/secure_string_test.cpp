@@ -1,5 +1,7 @@
 #include "secure_string.hpp"
 #include <gtest/gtest.h>
+#include <limits>
+#include <vector>
 
 bool is_zeroed(const char* data, size_t size)
 {
@@ -41,3 +43,217 @@ TEST(SecureStringTest, ClearMemory)
     s.clear();
     EXPECT_TRUE(is_zeroed(data, size));
 }
+
+TEST(SecureMemoryTest, SecureZero)
+{
+    char buffer[100];
+    std::memset(buffer, 'x', sizeof(buffer));
+    secure::secureZero(buffer + 1, sizeof(buffer) - 2);
+    EXPECT_EQ(buffer[0], 'x');
+    EXPECT_TRUE(is_zeroed(buffer + 1, sizeof(buffer) - 2));
+    EXPECT_EQ(buffer[sizeof(buffer) - 1], 'x');
+}
+
+TEST(SecureAllocatorTest, WipesOnlyOnDeallocate)
+{
+    std::vector<char, secure::SecureAllocator<char>> secret{'k', 'e', 'y'};
+    const char* data = secret.data();
+    // destroy() не обнуляет: байты остаются в ёмкости вектора до освобождения блока
+    secret.clear();
+    EXPECT_EQ(data, secret.data());
+    EXPECT_EQ('k', data[0]);
+    EXPECT_EQ('y', data[2]);
+
+    // SecureString обнуляет переиспользуемую ёмкость сам
+    secure::SecureString s("key");
+    const char* buffer = s.c_str();
+    s.clear();
+    EXPECT_TRUE(is_zeroed(buffer, 3));
+}
+
+TEST(SecureStringTest, AppendString)
+{
+    secure::SecureString s;
+    s.append("hello");
+    s.append(", ", 2);
+    s.append(secure::SecureString("world"));
+    s.append(std::string("!"));
+    EXPECT_EQ(s, "hello, world!");
+    EXPECT_EQ(s.size(), 13);
+}
+
+TEST(SecureStringTest, AppendGrowsGeometrically)
+{
+    secure::SecureString s;
+    size_t reallocations = 0;
+    size_t capacity = s.capacity();
+    for (int i = 0; i < 10000; ++i)
+    {
+        s.append("x", 1);
+        if (s.capacity() != capacity)
+        {
+            capacity = s.capacity();
+            ++reallocations;
+        }
+    }
+    EXPECT_EQ(s.size(), 10000);
+    EXPECT_LT(reallocations, 20);
+}
+
+TEST(SecureStringTest, ReserveKeepsBuffer)
+{
+    secure::SecureString s;
+    s.reserve(64);
+    EXPECT_GE(s.capacity(), 64);
+    s.append("begin");
+    const char* data = s.c_str();
+    for (int i = 0; i < 10; ++i)
+        s.append("_part");
+    EXPECT_EQ(data, s.c_str());
+    s.assign("short");
+    EXPECT_EQ(data, s.c_str());
+    EXPECT_EQ(s, "short");
+}
+
+TEST(SecureStringTest, TooLong)
+{
+    secure::SecureString s("abc");
+    EXPECT_THROW(s.reserve(std::numeric_limits<size_t>::max()), std::length_error);
+    EXPECT_THROW(s.append("x", std::numeric_limits<size_t>::max()), std::length_error);
+    EXPECT_EQ(s, "abc");
+}
+
+TEST(SecureStringTest, AppendSelf)
+{
+    secure::SecureString s("abc");
+    s.append(s);
+    EXPECT_EQ(s, "abcabc");
+    s.append(s.c_str() + 3, 3);
+    EXPECT_EQ(s, "abcabcabc");
+    s.assign(s.c_str() + 6, 3);
+    EXPECT_EQ(s, "abc");
+}
+
+TEST(SecureStringTest, CopyAssignReusesBuffer)
+{
+    secure::SecureString s1("long enough secret value");
+    secure::SecureString s2("short");
+    const char* data = s1.c_str();
+    s1 = s2;
+    EXPECT_EQ(data, s1.c_str());
+    EXPECT_EQ(s1, "short");
+}
+
+TEST(SecureMemoryTest, SecureEqual)
+{
+    const char a[] = "0123456789abcdefXYZ";
+    const char b[] = "0123456789abcdefXYz";
+    EXPECT_TRUE(secure::secureEqual(a, b, 18));
+    EXPECT_FALSE(secure::secureEqual(a, b, 19));
+    EXPECT_FALSE(secure::secureEqual(a, "1123456789abcdefXYZ", 19));
+    EXPECT_TRUE(secure::secureEqual(a, b, 0));
+}
+
+TEST(SecureMemoryTest, SecureEqualLengthHiding)
+{
+    EXPECT_TRUE(secure::secureEqual("token", 5, "token", 5));
+    EXPECT_FALSE(secure::secureEqual("token", 5, "toke", 4));
+    EXPECT_FALSE(secure::secureEqual("toke", 4, "token", 5));
+    EXPECT_FALSE(secure::secureEqual("token", 5, "tokeN", 5));
+    EXPECT_FALSE(secure::secureEqual("", 0, "t", 1));
+    EXPECT_TRUE(secure::secureEqual("", 0, "", 0));
+}
+
+TEST(SecureStringTest, CompareString)
+{
+    secure::SecureString s("secret");
+    EXPECT_TRUE(s == "secret");
+    EXPECT_TRUE(s != "secreT");
+    EXPECT_TRUE(s != "secret!");
+    EXPECT_TRUE(s != "");
+    EXPECT_TRUE(s.equals("secret", 6));
+    EXPECT_FALSE(s.equals("secret", 5));
+    EXPECT_EQ(s, secure::SecureString("secret"));
+    EXPECT_NE(s, secure::SecureString("Secret"));
+    EXPECT_EQ(secure::SecureString(), "");
+}
+
+using SsoSecureString = secure::sso_string::SecureString;
+
+TEST(SsoSecureStringTest, ShortStringIsInline)
+{
+    SsoSecureString s("1234");
+    EXPECT_EQ(s.size(), 4);
+    EXPECT_EQ(s.capacity(), SsoSecureString::inline_capacity());
+    const char* object = reinterpret_cast<const char*>(&s);
+    EXPECT_TRUE(s.c_str() >= object && s.c_str() < object + sizeof(s));
+    EXPECT_EQ(s, "1234");
+}
+
+TEST(SsoSecureStringTest, LongStringOnHeap)
+{
+    SsoSecureString s("0123456789012345678901");
+    EXPECT_EQ(s.capacity(), SsoSecureString::inline_capacity());
+    s.append("23");
+    EXPECT_GT(s.capacity(), SsoSecureString::inline_capacity());
+    EXPECT_EQ(s, "012345678901234567890123");
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_GT(s.capacity(), SsoSecureString::inline_capacity());
+}
+
+TEST(SsoSecureStringTest, MoveWipesInlineSource)
+{
+    SsoSecureString s1("pin_1234");
+    char* data = &s1[0];
+    size_t size = s1.size();
+    SsoSecureString s2 = std::move(s1);
+    EXPECT_EQ(s2, "pin_1234");
+    EXPECT_TRUE(s1.empty());
+    EXPECT_TRUE(is_zeroed(data, size));
+}
+
+TEST(SsoSecureStringTest, MoveHeapString)
+{
+    SsoSecureString s1("a long secret that does not fit inline");
+    const char* data = s1.c_str();
+    SsoSecureString s2;
+    s2 = std::move(s1);
+    EXPECT_EQ(data, s2.c_str());
+    EXPECT_TRUE(s1.empty());
+    EXPECT_EQ(s1.capacity(), SsoSecureString::inline_capacity());
+}
+
+TEST(SsoSecureStringTest, CopySwapAppend)
+{
+    SsoSecureString s1("short");
+    SsoSecureString s2("a long secret that does not fit inline");
+    SsoSecureString s3 = s1;
+    EXPECT_EQ(s1, s3);
+    s1.swap(s2);
+    EXPECT_EQ(s2, "short");
+    EXPECT_EQ(s1, "a long secret that does not fit inline");
+    s2.append(s2);
+    EXPECT_EQ(s2, "shortshort");
+    s2.assign(s2.c_str() + 5, 5);
+    EXPECT_EQ(s2, "short");
+}
+
+TEST(SsoSecureStringTest, TooLong)
+{
+    SsoSecureString s("abc");
+    EXPECT_THROW(s.reserve(std::numeric_limits<size_t>::max()), std::length_error);
+    EXPECT_THROW(s.reserve(SsoSecureString::max_size() + 1), std::length_error);
+    EXPECT_THROW(s.append("x", std::numeric_limits<size_t>::max()), std::length_error);
+    EXPECT_THROW(s.append("x", SsoSecureString::max_size()), std::length_error);
+    EXPECT_EQ(s, "abc");
+}
+
+TEST(SsoSecureStringTest, ClearMemory)
+{
+    SsoSecureString s("clear_me");
+    char* data = &s[0];
+    size_t size = s.size();
+    s.clear();
+    EXPECT_TRUE(is_zeroed(data, size));
+}
@@ -0,0 +1,236 @@
+#ifndef ATOMIC_SERVICE_LOCATOR_HPP
+#define ATOMIC_SERVICE_LOCATOR_HPP
+
+#include <array>
+#include <atomic>
+#include <boost/noncopyable.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+namespace singleton
+{
+
+namespace detail
+{
+
+/**
+ * Отслеживание читателей для отложенного удаления сервисов
+ * @note Читатели увеличивают счётчик текущей эпохи в своём слоте,
+ * писатель дважды меняет эпоху и дожидается обнуления счётчиков предыдущей
+ */
+class ReadDomain : private boost::noncopyable
+{
+    static const size_t SLOTS = 16;
+    struct alignas(64) Slot
+    {
+        std::atomic<size_t> readers[2];
+    };
+public:
+    static ReadDomain& instance()
+    {
+        static ReadDomain domain;
+        return domain;
+    }
+    std::atomic<size_t>& enter()
+    {
+        static thread_local const size_t index =
+            std::hash<std::thread::id>()(std::this_thread::get_id()) % SLOTS;
+        const unsigned epoch = m_epoch.load();
+        std::atomic<size_t>& counter = m_slots[index].readers[epoch & 1];
+        counter.fetch_add(1);
+        return counter;
+    }
+    void leave(std::atomic<size_t>& counter)
+    {
+        counter.fetch_sub(1, std::memory_order_release);
+    }
+    /**
+     * Дождаться выхода всех читателей, вошедших до вызова
+     * @attention Нельзя вызывать, удерживая ReadGuard в том же потоке
+     */
+    void synchronize()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (int round = 0; round < 2; ++round)
+        {
+            const unsigned epoch = m_epoch.fetch_add(1);
+            for (Slot& slot : m_slots)
+            {
+                while (slot.readers[epoch & 1].load() != 0)
+                    std::this_thread::yield();
+            }
+        }
+    }
+private:
+    ReadDomain() : m_epoch(0)
+    {
+        for (Slot& slot : m_slots)
+        {
+            slot.readers[0] = 0;
+            slot.readers[1] = 0;
+        }
+    }
+private:
+    std::array<Slot, SLOTS> m_slots;
+    std::atomic<unsigned> m_epoch;
+    std::mutex m_mutex;
+};
+
+} // namespace detail
+
+/**
+ * Потокобезопасный локатор сервиса
+ * get() - одна acquire загрузка указателя, set() и reset() публикуют сервис атомарно,
+ * а старый экземпляр удаляют после выхода читателей, удерживающих ReadGuard
+ * setLazy() откладывает создание сервиса до первого get()
+ * ScopedOverride подменяет сервис в текущем потоке без блокировок
+ * @attention Без ReadGuard ссылка из get() действительна до следующего set() или reset()
+ */
+template <typename T, size_t ID = 0>
+class AtomicServiceLocator : private boost::noncopyable
+{
+    AtomicServiceLocator() = delete;
+    ~AtomicServiceLocator() = delete;
+public:
+    /**
+     * Защищает полученные через get() сервисы от удаления
+     */
+    class ReadGuard : private boost::noncopyable
+    {
+    public:
+        ReadGuard() : m_counter(detail::ReadDomain::instance().enter())
+        {
+        }
+        ~ReadGuard()
+        {
+            detail::ReadDomain::instance().leave(m_counter);
+        }
+    private:
+        std::atomic<size_t>& m_counter;
+    };
+    /**
+     * Подменяет сервис для текущего потока на время жизни объекта
+     * @attention Подмены одного потока должны уничтожаться в обратном порядке
+     */
+    class ScopedOverride : private boost::noncopyable
+    {
+    public:
+        explicit ScopedOverride(T& service) : m_previous(local)
+        {
+            local = &service;
+        }
+        explicit ScopedOverride(std::unique_ptr<T> service)
+            : m_owned(std::move(service)), m_previous(local)
+        {
+            local = m_owned.get();
+        }
+        ~ScopedOverride()
+        {
+            local = m_previous;
+        }
+    private:
+        std::unique_ptr<T> m_owned;
+        T* m_previous;
+    };
+public:
+    template <typename... Args>
+    static void set(Args&&... args)
+    {
+        replace(new T(std::forward<Args>(args)...), nullptr);
+    }
+    /**
+     * Зарегистрировать сервис, который будет создан при первом get()
+     * @note Аргументы перемещаются в хранилище и при создании передаются в конструктор
+     * перемещением, поэтому годятся и некопируемые (std::unique_ptr). Фабрика вызывается
+     * один раз; если конструктор бросил исключение, повтор получит перемещённые аргументы
+     */
+    template <typename... Args>
+    static void setLazy(Args&&... args)
+    {
+        // std::function требует копируемой фабрики, поэтому аргументы разделяются
+        auto arguments =
+            std::make_shared<std::tuple<std::decay_t<Args>...>>(std::forward<Args>(args)...);
+        setFactory(
+            [arguments]()
+            {
+                return std::apply([](auto&... stored)
+                                  { return std::unique_ptr<T>(new T(std::move(stored)...)); },
+                                  *arguments);
+            });
+    }
+    static void setFactory(std::function<std::unique_ptr<T>()> factory)
+    {
+        replace(nullptr, std::unique_ptr<Factory>(new Factory(std::move(factory))));
+    }
+    static T& get()
+    {
+        if (T* service = local)
+            return *service;
+        T* service = holder.instance.load(std::memory_order_acquire);
+        return service ? *service : create();
+    }
+    static void reset()
+    {
+        replace(nullptr, nullptr);
+    }
+private:
+    using Factory = std::function<std::unique_ptr<T>()>;
+private:
+    // медленный путь get(): однократное создание зарегистрированного сервиса
+    static T& create()
+    {
+        std::lock_guard<std::mutex> lock(holder.mutex);
+        T* service = holder.instance.load(std::memory_order_acquire);
+        if (service)
+            return *service;
+        if (!holder.factory)
+            throw std::runtime_error("service is not instanced");
+        service = (*holder.factory)().release();
+        holder.instance.store(service, std::memory_order_release);
+        return *service;
+    }
+    // ожидание читателей идёт без мьютекса: читатель под ReadGuard может ждать его в create()
+    static void replace(T* service, std::unique_ptr<Factory> factory)
+    {
+        T* old = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(holder.mutex);
+            holder.factory = std::move(factory);
+            old = holder.instance.exchange(service);
+        }
+        if (old)
+        {
+            detail::ReadDomain::instance().synchronize();
+            delete old;
+        }
+    }
+private:
+    // удаляет сервис при завершении программы
+    struct Holder
+    {
+        ~Holder()
+        {
+            delete instance.load();
+        }
+        std::atomic<T*> instance{nullptr};
+        std::mutex mutex;
+        std::unique_ptr<Factory> factory;
+    };
+    static Holder holder;
+    static thread_local T* local;
+};
+
+// static
+template <typename T, size_t ID>
+typename AtomicServiceLocator<T, ID>::Holder AtomicServiceLocator<T, ID>::holder{};
+template <typename T, size_t ID>
+thread_local T* AtomicServiceLocator<T, ID>::local = nullptr;
+
+} // namespace singleton
+
+#endif // ATOMIC_SERVICE_LOCATOR_HPP
@@ -0,0 +1,265 @@
+#include "atomic_service_locator.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+struct CountedService
+{
+    CountedService(int v = 100) : value(v)
+    {
+        ++alive;
+    }
+    ~CountedService()
+    {
+        --alive;
+    }
+    const int value;
+    static std::atomic<int> alive;
+};
+
+std::atomic<int> CountedService::alive{0};
+
+TEST(AtomicServiceLocator, serviceReuse)
+{
+    using Locator = singleton::AtomicServiceLocator<CountedService>;
+    EXPECT_THROW(Locator::get(), std::runtime_error);
+
+    Locator::set();
+    EXPECT_EQ(100, Locator::get().value);
+    Locator::set(200);
+    EXPECT_EQ(200, Locator::get().value);
+    EXPECT_EQ(1, CountedService::alive);
+
+    Locator::reset();
+    EXPECT_EQ(0, CountedService::alive);
+    EXPECT_THROW(Locator::get(), std::runtime_error);
+}
+
+TEST(AtomicServiceLocator, multipleServices)
+{
+    singleton::AtomicServiceLocator<CountedService, 1>::set(1);
+    singleton::AtomicServiceLocator<CountedService, 2>::set(2);
+    EXPECT_EQ(1, (singleton::AtomicServiceLocator<CountedService, 1>::get().value));
+    EXPECT_EQ(2, (singleton::AtomicServiceLocator<CountedService, 2>::get().value));
+    singleton::AtomicServiceLocator<CountedService, 1>::reset();
+    singleton::AtomicServiceLocator<CountedService, 2>::reset();
+}
+
+TEST(AtomicServiceLocator, conceptsCheck)
+{
+    using Locator = singleton::AtomicServiceLocator<CountedService>;
+    EXPECT_FALSE(std::is_constructible<Locator>::value);
+    EXPECT_FALSE(std::is_destructible<Locator>::value);
+    EXPECT_FALSE(std::is_copy_constructible<Locator>::value);
+    EXPECT_FALSE(std::is_copy_assignable<Locator>::value);
+}
+
+TEST(AtomicServiceLocator, concurrentReplace)
+{
+    using Locator = singleton::AtomicServiceLocator<CountedService, 3>;
+    Locator::set(0);
+    std::atomic<bool> stop{false};
+    std::atomic<int> errors{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (!stop.load())
+                {
+                    Locator::ReadGuard guard;
+                    const CountedService& service = Locator::get();
+                    const int first = service.value;
+                    std::this_thread::yield();
+                    if (service.value != first || first < 0)
+                        ++errors;
+                }
+            });
+    }
+    for (int i = 1; i <= 200; ++i)
+        Locator::set(i);
+    stop = true;
+    for (std::thread& reader : readers)
+        reader.join();
+    EXPECT_EQ(0, errors);
+    EXPECT_EQ(200, Locator::get().value);
+    Locator::reset();
+    EXPECT_EQ(0, CountedService::alive);
+}
+
+TEST(AtomicServiceLocator, lazyService)
+{
+    using Locator = singleton::AtomicServiceLocator<CountedService, 4>;
+    Locator::setLazy(400);
+    EXPECT_EQ(0, CountedService::alive);
+    EXPECT_EQ(400, Locator::get().value);
+    EXPECT_EQ(1, CountedService::alive);
+    EXPECT_EQ(&Locator::get(), &Locator::get());
+
+    Locator::reset();
+    EXPECT_EQ(0, CountedService::alive);
+    EXPECT_THROW(Locator::get(), std::runtime_error);
+}
+
+TEST(AtomicServiceLocator, lazyServiceCreatedOnce)
+{
+    using Locator = singleton::AtomicServiceLocator<CountedService, 5>;
+    std::atomic<int> created{0};
+    Locator::setFactory(
+        [&created]()
+        {
+            ++created;
+            return std::unique_ptr<CountedService>(new CountedService(500));
+        });
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+        threads.emplace_back([]() { EXPECT_EQ(500, Locator::get().value); });
+    for (std::thread& thread : threads)
+        thread.join();
+    EXPECT_EQ(1, created);
+    Locator::reset();
+}
+
+struct MoveOnlyService
+{
+    explicit MoveOnlyService(std::unique_ptr<int> v, std::string name)
+        : value(std::move(v)), name(std::move(name))
+    {
+    }
+    std::unique_ptr<int> value;
+    std::string name;
+};
+
+TEST(AtomicServiceLocator, lazyServiceMoveOnlyArguments)
+{
+    using Locator = singleton::AtomicServiceLocator<MoveOnlyService>;
+    Locator::setLazy(std::unique_ptr<int>(new int(42)), std::string("lazy"));
+    EXPECT_EQ(42, *Locator::get().value);
+    EXPECT_EQ("lazy", Locator::get().name);
+    Locator::reset();
+}
+
+// повторная ленивая регистрация поверх созданного сервиса, пока читатель под ReadGuard
+// создаёт новый через get()
+TEST(AtomicServiceLocator, lazyReRegistration)
+{
+    using Locator = singleton::AtomicServiceLocator<CountedService, 9>;
+    Locator::setLazy(1);
+    EXPECT_EQ(1, Locator::get().value);
+    std::atomic<bool> guarded{false};
+    std::atomic<bool> replacing{false};
+    std::thread reader(
+        [&]()
+        {
+            Locator::ReadGuard guard;
+            guarded = true;
+            while (!replacing.load())
+                std::this_thread::yield();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const int value = Locator::get().value;
+            EXPECT_TRUE(value == 1 || value == 2) << value;
+        });
+    while (!guarded.load())
+        std::this_thread::yield();
+    replacing = true;
+    Locator::setLazy(2);
+    reader.join();
+    EXPECT_EQ(2, Locator::get().value);
+    EXPECT_EQ(1, CountedService::alive);
+    Locator::reset();
+    EXPECT_EQ(0, CountedService::alive);
+}
+
+// читатель под ReadGuard обращается к пустому или ленивому сервису, пока писатель
+// ждёт выхода читателей
+TEST(AtomicServiceLocator, guardedGetDuringReplace)
+{
+    using Locator = singleton::AtomicServiceLocator<CountedService, 8>;
+    for (bool lazy : {true, false})
+    {
+        Locator::set(1);
+        std::atomic<bool> guarded{false};
+        std::atomic<bool> replacing{false};
+        std::thread reader(
+            [&]()
+            {
+                Locator::ReadGuard guard;
+                guarded = true;
+                while (!replacing.load())
+                    std::this_thread::yield();
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                if (lazy)
+                {
+                    const int value = Locator::get().value;
+                    EXPECT_TRUE(value == 1 || value == 800) << value;
+                }
+                else
+                {
+                    try
+                    {
+                        EXPECT_EQ(1, Locator::get().value);
+                    }
+                    catch (const std::runtime_error&)
+                    {
+                    }
+                }
+            });
+        while (!guarded.load())
+            std::this_thread::yield();
+        std::thread writer(
+            [&]()
+            {
+                replacing = true;
+                if (lazy)
+                    Locator::setLazy(800);
+                else
+                    Locator::reset();
+            });
+        writer.join();
+        reader.join();
+        Locator::reset();
+    }
+    EXPECT_EQ(0, CountedService::alive);
+}
+
+TEST(AtomicServiceLocator, scopedOverride)
+{
+    using Locator = singleton::AtomicServiceLocator<CountedService, 6>;
+    Locator::set(600);
+    {
+        CountedService local(1);
+        Locator::ScopedOverride outer(local);
+        EXPECT_EQ(1, Locator::get().value);
+        {
+            Locator::ScopedOverride inner(std::unique_ptr<CountedService>(new CountedService(2)));
+            EXPECT_EQ(2, Locator::get().value);
+            std::thread other([]() { EXPECT_EQ(600, Locator::get().value); });
+            other.join();
+        }
+        EXPECT_EQ(1, Locator::get().value);
+    }
+    EXPECT_EQ(600, Locator::get().value);
+    Locator::reset();
+    EXPECT_EQ(0, CountedService::alive);
+}
+
+TEST(AtomicServiceLocator, scopedOverrideWithoutGlobal)
+{
+    using Locator = singleton::AtomicServiceLocator<CountedService, 7>;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back(
+            [t]()
+            {
+                Locator::ScopedOverride cache(
+                    std::unique_ptr<CountedService>(new CountedService(t)));
+                for (int i = 0; i < 1000; ++i)
+                    EXPECT_EQ(t, Locator::get().value);
+            });
+    }
+    for (std::thread& worker : workers)
+        worker.join();
+    EXPECT_THROW(Locator::get(), std::runtime_error);
+}
@@ -0,0 +1,61 @@
+#include "atomic_service_locator.hpp"
+#include "service_locator.hpp"
+#include <benchmark/benchmark.h>
+
+struct BenchService
+{
+    int value = 1;
+};
+
+static void BM_ServiceLocatorGet(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+        singleton::ServiceLocator<BenchService>::set();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(singleton::ServiceLocator<BenchService>::get().value);
+    }
+    if (state.thread_index() == 0)
+        singleton::ServiceLocator<BenchService>::reset();
+}
+BENCHMARK(BM_ServiceLocatorGet)->ThreadRange(1, 8);
+
+static void BM_AtomicServiceLocatorGet(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+        singleton::AtomicServiceLocator<BenchService>::set();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(singleton::AtomicServiceLocator<BenchService>::get().value);
+    }
+    if (state.thread_index() == 0)
+        singleton::AtomicServiceLocator<BenchService>::reset();
+}
+BENCHMARK(BM_AtomicServiceLocatorGet)->ThreadRange(1, 8);
+
+static void BM_AtomicServiceLocatorGuardedGet(benchmark::State& state)
+{
+    using Locator = singleton::AtomicServiceLocator<BenchService, 1>;
+    if (state.thread_index() == 0)
+        Locator::set();
+    for (auto _ : state)
+    {
+        Locator::ReadGuard guard;
+        benchmark::DoNotOptimize(Locator::get().value);
+    }
+    if (state.thread_index() == 0)
+        Locator::reset();
+}
+BENCHMARK(BM_AtomicServiceLocatorGuardedGet)->ThreadRange(1, 8);
+
+static void BM_AtomicServiceLocatorOverriddenGet(benchmark::State& state)
+{
+    using Locator = singleton::AtomicServiceLocator<BenchService, 2>;
+    BenchService local;
+    Locator::ScopedOverride override(local);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Locator::get().value);
+    }
+}
+BENCHMARK(BM_AtomicServiceLocatorOverriddenGet)->ThreadRange(1, 8);
@@ -0,0 +1,173 @@
+#ifndef STARTUP_HPP
+#define STARTUP_HPP
+
+#include "atomic_service_locator.hpp"
+#include <algorithm>
+#include <boost/noncopyable.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <vector>
+
+namespace singleton
+{
+
+/**
+ * Инициализация ленивых сервисов с учётом зависимостей
+ * @note Сервисы регистрируются через AtomicServiceLocator::setLazy, поэтому не попавшие
+ * в run() сервисы по-прежнему создаются при первом get()
+ */
+class Startup : private boost::noncopyable
+{
+public:
+    /**
+     * Время инициализации сервиса относительно начала run()
+     */
+    struct Timing
+    {
+        std::string name;
+        std::chrono::nanoseconds start;
+        std::chrono::nanoseconds duration;
+    };
+public:
+    /**
+     * Зарегистрировать ленивый сервис
+     */
+    template <typename T, size_t ID = 0, typename... Args>
+    Startup& add(const std::string& name, Args&&... args)
+    {
+        AtomicServiceLocator<T, ID>::setLazy(std::forward<Args>(args)...);
+        Node node;
+        node.name = name;
+        node.key = std::type_index(typeid(AtomicServiceLocator<T, ID>));
+        node.init = []() { AtomicServiceLocator<T, ID>::get(); };
+        m_nodes.push_back(std::move(node));
+        return *this;
+    }
+    /**
+     * Объявить зависимость последнего добавленного сервиса от ранее добавленного
+     */
+    template <typename T, size_t ID = 0>
+    Startup& after()
+    {
+        if (m_nodes.empty())
+            throw std::logic_error("no service to add dependency to");
+        const std::type_index key(typeid(AtomicServiceLocator<T, ID>));
+        const size_t last = m_nodes.size() - 1;
+        for (size_t i = 0; i < last; ++i)
+        {
+            if (m_nodes[i].key == key)
+            {
+                m_nodes[i].dependents.push_back(last);
+                ++m_nodes[last].dependencies;
+                return *this;
+            }
+        }
+        throw std::logic_error("dependency is not registered before service");
+    }
+    /**
+     * Создать все сервисы, независимые - параллельно
+     * @note Первое исключение из конструктора сервиса пробрасывается после остановки потоков
+     */
+    void run(size_t threads = std::thread::hardware_concurrency())
+    {
+        m_timings.clear();
+        const size_t count = m_nodes.size();
+        std::vector<size_t> pending(count);
+        std::deque<size_t> ready;
+        for (size_t i = 0; i < count; ++i)
+        {
+            pending[i] = m_nodes[i].dependencies;
+            if (pending[i] == 0)
+                ready.push_back(i);
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t done = 0;
+        std::exception_ptr error;
+        const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+        auto worker = [&]()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                cv.wait(lock, [&]() { return !ready.empty() || done == count || error; });
+                if (done == count || error)
+                    return;
+                const size_t i = ready.front();
+                ready.pop_front();
+                lock.unlock();
+
+                const std::chrono::steady_clock::time_point start =
+                    std::chrono::steady_clock::now();
+                std::exception_ptr failure;
+                try
+                {
+                    m_nodes[i].init();
+                }
+                catch (...)
+                {
+                    failure = std::current_exception();
+                }
+                const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+                lock.lock();
+                if (failure)
+                {
+                    error = failure;
+                    cv.notify_all();
+                    return;
+                }
+                m_timings.push_back(Timing{m_nodes[i].name, start - begin, end - start});
+                ++done;
+                for (size_t dependent : m_nodes[i].dependents)
+                {
+                    if (--pending[dependent] == 0)
+                        ready.push_back(dependent);
+                }
+                cv.notify_all();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        const size_t size = std::max<size_t>(1, std::min(threads, count));
+        for (size_t t = 0; t < size; ++t)
+            pool.emplace_back(worker);
+        for (std::thread& thread : pool)
+            thread.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+    /**
+     * Времена инициализации в порядке завершения
+     */
+    const std::vector<Timing>& report() const
+    {
+        return m_timings;
+    }
+private:
+    struct Node
+    {
+        std::string name;
+        std::type_index key = std::type_index(typeid(void));
+        std::function<void()> init;
+        std::vector<size_t> dependents;
+        size_t dependencies = 0;
+    };
+private:
+    std::vector<Node> m_nodes;
+    std::vector<Timing> m_timings;
+};
+
+} // namespace singleton
+
+#endif // STARTUP_HPP
@@ -0,0 +1,87 @@
+#include "startup.hpp"
+#include <gtest/gtest.h>
+
+struct Config
+{
+    Config(int v) : value(v)
+    {
+    }
+    const int value;
+};
+
+struct Database
+{
+    Database() : port(singleton::AtomicServiceLocator<Config>::get().value)
+    {
+    }
+    const int port;
+};
+
+struct Cache
+{
+    Cache() : size(singleton::AtomicServiceLocator<Config>::get().value * 2)
+    {
+    }
+    const int size;
+};
+
+struct Api
+{
+    Api()
+        : ready(singleton::AtomicServiceLocator<Database>::get().port +
+                singleton::AtomicServiceLocator<Cache>::get().size)
+    {
+    }
+    const int ready;
+};
+
+struct Broken
+{
+    Broken()
+    {
+        throw std::runtime_error("broken service");
+    }
+};
+
+TEST(Startup, dependencyOrder)
+{
+    singleton::Startup startup;
+    startup.add<Config>("config", 10);
+    startup.add<Database>("database").after<Config>();
+    startup.add<Cache>("cache").after<Config>();
+    startup.add<Api>("api").after<Database>().after<Cache>();
+    startup.run(4);
+
+    EXPECT_EQ(30, singleton::AtomicServiceLocator<Api>::get().ready);
+
+    const std::vector<singleton::Startup::Timing>& report = startup.report();
+    ASSERT_EQ(4u, report.size());
+    EXPECT_EQ("config", report.front().name);
+    EXPECT_EQ("api", report.back().name);
+    for (const singleton::Startup::Timing& timing : report)
+        EXPECT_GE(timing.duration.count(), 0);
+
+    singleton::AtomicServiceLocator<Api>::reset();
+    singleton::AtomicServiceLocator<Cache>::reset();
+    singleton::AtomicServiceLocator<Database>::reset();
+    singleton::AtomicServiceLocator<Config>::reset();
+}
+
+TEST(Startup, unknownDependency)
+{
+    singleton::Startup startup;
+    EXPECT_THROW(startup.after<Config>(), std::logic_error);
+    startup.add<Database>("database");
+    EXPECT_THROW(startup.after<Config>(), std::logic_error);
+    singleton::AtomicServiceLocator<Database>::reset();
+}
+
+TEST(Startup, failedService)
+{
+    singleton::Startup startup;
+    startup.add<Config>("config", 1);
+    startup.add<Broken>("broken").after<Config>();
+    EXPECT_THROW(startup.run(2), std::runtime_error);
+    singleton::AtomicServiceLocator<Broken>::reset();
+    singleton::AtomicServiceLocator<Config>::reset();
+}
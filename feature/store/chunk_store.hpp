@@ -0,0 +1,548 @@
+#ifndef CHUNK_STORE_HPP
+#define CHUNK_STORE_HPP
+
+#include "../hash/hash_stream.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace store
+{
+
+namespace detail
+{
+
+constexpr std::uint64_t splitmix64(std::uint64_t& state)
+{
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// случайные значения байтов для Gear хэша, одинаковые во всех сборках
+constexpr std::array<std::uint64_t, 256> makeGearTable()
+{
+    std::array<std::uint64_t, 256> table{};
+    std::uint64_t state = 0;
+    for (std::uint64_t& value : table)
+        value = splitmix64(state);
+    return table;
+}
+
+inline constexpr std::array<std::uint64_t, 256> GEAR = makeGearTable();
+
+[[noreturn]] inline void throwErrno(const std::string& what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// дескриптор файла, закрываемый в деструкторе
+class File
+{
+public:
+    File() = default;
+    File(const std::filesystem::path& path, int flags)
+        : m_fd(::open(path.c_str(), flags | O_CLOEXEC, 0644))
+    {
+        if (m_fd < 0)
+            throwErrno("open " + path.string());
+    }
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+    File(File&& other) noexcept : m_fd(other.m_fd)
+    {
+        other.m_fd = -1;
+    }
+    File& operator=(File&& other) noexcept
+    {
+        std::swap(m_fd, other.m_fd);
+        return *this;
+    }
+    ~File()
+    {
+        if (m_fd >= 0)
+            ::close(m_fd);
+    }
+    int fd() const
+    {
+        return m_fd;
+    }
+    std::uint64_t size() const
+    {
+        struct stat st;
+        if (::fstat(m_fd, &st) != 0)
+            throwErrno("fstat");
+        return static_cast<std::uint64_t>(st.st_size);
+    }
+    void resize(std::uint64_t size)
+    {
+        if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0)
+            throwErrno("ftruncate");
+    }
+    void writeAt(const char* data, std::size_t size, std::uint64_t offset)
+    {
+        while (size > 0)
+        {
+            const ssize_t written = ::pwrite(m_fd, data, size, static_cast<off_t>(offset));
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throwErrno("pwrite");
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+            offset += static_cast<std::uint64_t>(written);
+        }
+    }
+    void readAt(char* data, std::size_t size, std::uint64_t offset) const
+    {
+        while (size > 0)
+        {
+            const ssize_t count = ::pread(m_fd, data, size, static_cast<off_t>(offset));
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throwErrno("pread");
+            }
+            if (count == 0)
+                throw std::runtime_error("chunk data is truncated");
+            data += count;
+            size -= static_cast<std::size_t>(count);
+            offset += static_cast<std::uint64_t>(count);
+        }
+    }
+private:
+    int m_fd = -1;
+};
+
+} // namespace detail
+
+/**
+ * Разбиение на фрагменты по содержимому (Gear хэш)
+ * @note Граница зависит только от последних 64 байт, поэтому вставка в середину данных
+ * меняет лишь соседние фрагменты, а остальные совпадают с уже сохранёнными
+ */
+class Chunker
+{
+public:
+    /**
+     * @param averageSize степень двойки, ожидаемый размер фрагмента
+     */
+    explicit Chunker(std::size_t minSize = 2048, std::size_t averageSize = 8192,
+                     std::size_t maxSize = 65536)
+        : m_min(minSize), m_max(maxSize)
+    {
+        if (averageSize < 2 || (averageSize & (averageSize - 1)) != 0)
+            throw std::invalid_argument("average chunk size must be a power of two");
+        if (minSize == 0 || minSize >= averageSize || averageSize > maxSize)
+            throw std::invalid_argument("chunk sizes must satisfy 0 < min < average <= max");
+        // размер фрагмента хранится в индексе 32-битным
+        if (maxSize > std::numeric_limits<std::uint32_t>::max())
+            throw std::invalid_argument("maximum chunk size must fit in 32 bits");
+        // старшие биты Gear хэша зависят от большего числа байтов, чем младшие
+        std::size_t bits = 0;
+        while ((std::size_t(1) << bits) < averageSize)
+            ++bits;
+        m_mask = ((std::uint64_t(1) << bits) - 1) << (64 - bits);
+    }
+    /**
+     * Длина следующего фрагмента в начале data
+     */
+    std::size_t next(const char* data, std::size_t size) const
+    {
+        if (size <= m_min)
+            return size;
+        const std::size_t limit = std::min(size, m_max);
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        std::uint64_t hash = 0;
+        for (std::size_t i = m_min; i < limit; ++i)
+        {
+            hash = (hash << 1) + detail::GEAR[bytes[i]];
+            if ((hash & m_mask) == 0)
+                return i + 1;
+        }
+        return limit;
+    }
+    std::size_t maxSize() const
+    {
+        return m_max;
+    }
+private:
+    std::size_t m_min;
+    std::size_t m_max;
+    std::uint64_t m_mask = 0;
+};
+
+/**
+ * Хранилище фрагментов с адресацией по содержимому
+ * Фрагмент хранится один раз под своим SHA-256, блоб описывается списком ключей
+ * @note Каталог содержит chunks.dat (данные, только дозапись) и index.dat (таблица
+ * с открытой адресацией, отображённая в память). Чтения идут параллельно,
+ * запись нового фрагмента и рост индекса - под исключительной блокировкой.
+ * Долговечность на диске гарантируется только после flush()
+ */
+class ChunkStore
+{
+public:
+    using Recipe = std::vector<hash::Hash>;
+    static constexpr std::size_t KEY_SIZE = 32;
+
+    struct Stats
+    {
+        std::uint64_t chunks = 0;       // фрагментов в индексе
+        std::uint64_t storedBytes = 0;  // размер файла данных
+        std::uint64_t putBytes = 0;     // передано в put за время жизни объекта
+        std::uint64_t writtenBytes = 0; // из них записано, остальное - повторы
+    };
+public:
+    explicit ChunkStore(const std::filesystem::path& directory, Chunker chunker = Chunker())
+        : m_directory(directory), m_chunker(chunker)
+    {
+        std::filesystem::create_directories(m_directory);
+        m_data = detail::File(m_directory / DATA_FILE, O_RDWR | O_CREAT);
+        m_dataEnd = m_data.size();
+        openIndex();
+    }
+    ChunkStore(const ChunkStore&) = delete;
+    ChunkStore& operator=(const ChunkStore&) = delete;
+    ~ChunkStore()
+    {
+        unmap();
+    }
+public:
+    /**
+     * Сохранить один фрагмент
+     * @return ключ фрагмента; повторный фрагмент не записывается
+     * @throw std::length_error, если размер не помещается в 32 бита индекса
+     */
+    hash::Hash putChunk(const char* data, std::size_t size)
+    {
+        if (size > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("chunk is too large for the index");
+        const hash::Hash key = digest(data, size);
+        m_putBytes.fetch_add(size, std::memory_order_relaxed);
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            if (find(key.data()))
+                return key;
+        }
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (find(key.data()))
+            return key;
+        if ((header().count + 1) * 2 > header().capacity)
+            rehash(header().capacity * 2);
+        m_data.writeAt(data, size, m_dataEnd);
+        insert(key.data(), m_dataEnd, static_cast<std::uint32_t>(size));
+        m_dataEnd += size;
+        m_writtenBytes.fetch_add(size, std::memory_order_relaxed);
+        return key;
+    }
+    /**
+     * Разбить данные на фрагменты и сохранить новые
+     */
+    Recipe put(const char* data, std::size_t size)
+    {
+        Recipe recipe;
+        while (size > 0)
+        {
+            const std::size_t length = m_chunker.next(data, size);
+            recipe.push_back(putChunk(data, length));
+            data += length;
+            size -= length;
+        }
+        return recipe;
+    }
+    Recipe put(const std::string& data)
+    {
+        return put(data.data(), data.size());
+    }
+    /**
+     * Сохранить поток до конца, в памяти держится несколько максимальных фрагментов
+     */
+    Recipe put(std::istream& input)
+    {
+        Recipe recipe;
+        std::vector<char> buffer(4 * m_chunker.maxSize());
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        bool eof = false;
+        while (true)
+        {
+            if (!eof && end - begin < m_chunker.maxSize())
+            {
+                std::copy(buffer.begin() + static_cast<std::ptrdiff_t>(begin),
+                          buffer.begin() + static_cast<std::ptrdiff_t>(end), buffer.begin());
+                end -= begin;
+                begin = 0;
+                input.read(buffer.data() + end, static_cast<std::streamsize>(buffer.size() - end));
+                end += static_cast<std::size_t>(input.gcount());
+                if (input.bad())
+                    throw std::runtime_error("failed to read chunk store input");
+                eof = !input;
+                continue;
+            }
+            if (begin == end)
+                break;
+            const std::size_t length = m_chunker.next(buffer.data() + begin, end - begin);
+            recipe.push_back(putChunk(buffer.data() + begin, length));
+            begin += length;
+        }
+        return recipe;
+    }
+    bool contains(const hash::Hash& key) const
+    {
+        if (key.size() != KEY_SIZE)
+            return false;
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return find(key.data()) != nullptr;
+    }
+    /**
+     * Прочитать фрагмент
+     * @return false, если фрагмента нет
+     */
+    bool getChunk(const hash::Hash& key, std::string& out) const
+    {
+        if (key.size() != KEY_SIZE)
+            return false;
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        const Entry* entry = find(key.data());
+        if (!entry)
+            return false;
+        out.resize(entry->size);
+        m_data.readAt(out.data(), entry->size, entry->offset);
+        return true;
+    }
+    /**
+     * Собрать блоб по списку ключей
+     * @throw std::out_of_range, если фрагмента нет
+     */
+    std::string get(const Recipe& recipe) const
+    {
+        std::string result;
+        std::string chunk;
+        for (const hash::Hash& key : recipe)
+        {
+            if (!getChunk(key, chunk))
+                throw std::out_of_range("chunk is not found: " + key.toString());
+            result += chunk;
+        }
+        return result;
+    }
+    Stats stats() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        Stats result;
+        result.chunks = header().count;
+        result.storedBytes = m_dataEnd;
+        result.putBytes = m_putBytes.load(std::memory_order_relaxed);
+        result.writtenBytes = m_writtenBytes.load(std::memory_order_relaxed);
+        return result;
+    }
+    /**
+     * Сбросить данные и индекс на диск
+     */
+    void flush()
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (::fdatasync(m_data.fd()) != 0)
+            detail::throwErrno("fdatasync");
+        if (::msync(m_map, m_mapSize, MS_SYNC) != 0)
+            detail::throwErrno("msync");
+    }
+private:
+    static constexpr const char* DATA_FILE = "chunks.dat";
+    static constexpr const char* INDEX_FILE = "index.dat";
+    static constexpr char MAGIC[8] = {'C', 'H', 'U', 'N', 'K', 'I', 'X', '1'};
+    static constexpr std::uint64_t INITIAL_CAPACITY = 1024;
+
+    struct Header
+    {
+        char magic[8];
+        std::uint64_t capacity;
+        std::uint64_t count;
+        std::uint64_t reserved[5];
+    };
+    struct Entry
+    {
+        unsigned char key[KEY_SIZE];
+        std::uint64_t offset;
+        std::uint32_t size;
+        std::uint32_t used;
+    };
+    static_assert(sizeof(Header) == 64 && sizeof(Entry) == 48, "index layout changed");
+private:
+    static hash::Hash digest(const char* data, std::size_t size)
+    {
+        hash::Hash result(EVP_MAX_MD_SIZE);
+        unsigned int len = 0;
+        OSSL_ASSERT(EVP_Digest(data, size, result.data(), &len, EVP_sha256(), nullptr));
+        result.resize(len);
+        return result;
+    }
+    static std::uint64_t indexSize(std::uint64_t capacity)
+    {
+        return sizeof(Header) + capacity * sizeof(Entry);
+    }
+    Header& header() const
+    {
+        return *static_cast<Header*>(m_map);
+    }
+    Entry* entries() const
+    {
+        return reinterpret_cast<Entry*>(static_cast<char*>(m_map) + sizeof(Header));
+    }
+    // ключ - равномерный хэш, его первые байты годятся как номер ячейки
+    static std::uint64_t slot(const unsigned char* key)
+    {
+        std::uint64_t result = 0;
+        std::memcpy(&result, key, sizeof(result));
+        return result;
+    }
+    const Entry* find(const unsigned char* key) const
+    {
+        const std::uint64_t mask = header().capacity - 1;
+        for (std::uint64_t i = slot(key) & mask;; i = (i + 1) & mask)
+        {
+            const Entry& entry = entries()[i];
+            if (!entry.used)
+                return nullptr;
+            if (std::memcmp(entry.key, key, KEY_SIZE) == 0)
+                return &entry;
+        }
+    }
+    static void insertInto(Header& header, Entry* entries, const unsigned char* key,
+                           std::uint64_t offset, std::uint32_t size)
+    {
+        const std::uint64_t mask = header.capacity - 1;
+        std::uint64_t i = slot(key) & mask;
+        while (entries[i].used)
+            i = (i + 1) & mask;
+        std::memcpy(entries[i].key, key, KEY_SIZE);
+        entries[i].offset = offset;
+        entries[i].size = size;
+        entries[i].used = 1;
+        ++header.count;
+    }
+    void insert(const unsigned char* key, std::uint64_t offset, std::uint32_t size)
+    {
+        insertInto(header(), entries(), key, offset, size);
+    }
+    void map(detail::File& file, std::uint64_t size)
+    {
+        void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd(), 0);
+        if (memory == MAP_FAILED)
+            detail::throwErrno("mmap");
+        unmap();
+        m_map = memory;
+        m_mapSize = size;
+        m_index = std::move(file);
+    }
+    void unmap()
+    {
+        if (m_map)
+            ::munmap(m_map, m_mapSize);
+        m_map = nullptr;
+        m_mapSize = 0;
+    }
+    void openIndex()
+    {
+        detail::File file(m_directory / INDEX_FILE, O_RDWR | O_CREAT);
+        const std::uint64_t size = file.size();
+        if (size == 0)
+        {
+            file.resize(indexSize(INITIAL_CAPACITY));
+            map(file, indexSize(INITIAL_CAPACITY));
+            std::memcpy(header().magic, MAGIC, sizeof(MAGIC));
+            header().capacity = INITIAL_CAPACITY;
+            return;
+        }
+        if (size < sizeof(Header))
+            throw std::runtime_error("chunk store index is truncated");
+        map(file, size);
+        const std::uint64_t capacity = header().capacity;
+        if (std::memcmp(header().magic, MAGIC, sizeof(MAGIC)) != 0 || capacity == 0 ||
+            (capacity & (capacity - 1)) != 0 || indexSize(capacity) != size)
+        {
+            unmap();
+            throw std::runtime_error("chunk store index is corrupted");
+        }
+    }
+    // новая таблица строится во временном файле и атомарно заменяет старую,
+    // при ошибке временный файл удаляется, а старая таблица остаётся в работе
+    void rehash(std::uint64_t capacity)
+    {
+        const std::filesystem::path path = m_directory / INDEX_FILE;
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        detail::File file(temporary, O_RDWR | O_CREAT | O_TRUNC);
+        const std::uint64_t size = indexSize(capacity);
+        void* memory = MAP_FAILED;
+        try
+        {
+            file.resize(size);
+            memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd(), 0);
+            if (memory == MAP_FAILED)
+                detail::throwErrno("mmap");
+            Header& target = *static_cast<Header*>(memory);
+            Entry* targetEntries =
+                reinterpret_cast<Entry*>(static_cast<char*>(memory) + sizeof(Header));
+            std::memcpy(target.magic, MAGIC, sizeof(MAGIC));
+            target.capacity = capacity;
+            for (std::uint64_t i = 0; i < header().capacity; ++i)
+            {
+                const Entry& entry = entries()[i];
+                if (entry.used)
+                    insertInto(target, targetEntries, entry.key, entry.offset, entry.size);
+            }
+            std::filesystem::rename(temporary, path);
+        }
+        catch (...)
+        {
+            if (memory != MAP_FAILED)
+                ::munmap(memory, size);
+            std::error_code ignored;
+            std::filesystem::remove(temporary, ignored);
+            throw;
+        }
+        unmap();
+        m_map = memory;
+        m_mapSize = size;
+        m_index = std::move(file);
+    }
+private:
+    std::filesystem::path m_directory;
+    Chunker m_chunker;
+    mutable std::shared_mutex m_mutex;
+    detail::File m_data;
+    detail::File m_index;
+    std::uint64_t m_dataEnd = 0;
+    void* m_map = nullptr;
+    std::uint64_t m_mapSize = 0;
+    std::atomic<std::uint64_t> m_putBytes{0};
+    std::atomic<std::uint64_t> m_writtenBytes{0};
+};
+
+} // namespace store
+
+#endif // CHUNK_STORE_HPP
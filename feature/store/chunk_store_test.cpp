@@ -0,0 +1,241 @@
+#include "chunk_store.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <thread>
+
+using namespace store;
+
+/**
+ * Фикстура с временным каталогом хранилища
+ */
+class ChunkStoreFixture : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const testing::TestInfo* info = testing::UnitTest::GetInstance()->current_test_info();
+        directory = std::filesystem::temp_directory_path() /
+                    ("chunk_store_" + std::to_string(::getpid()) + "_" + info->name());
+        std::filesystem::remove_all(directory);
+    }
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+    static std::string randomData(std::size_t size, unsigned seed)
+    {
+        std::mt19937 generator(seed);
+        std::string data(size, '\0');
+        for (char& c : data)
+            c = static_cast<char>(generator());
+        return data;
+    }
+protected:
+    std::filesystem::path directory;
+};
+
+TEST(ChunkerTest, Bounds)
+{
+    const Chunker chunker(64, 256, 1024);
+    const std::string data = std::string(10000, 'a');
+    EXPECT_EQ(10u, chunker.next(data.data(), 10));
+    EXPECT_EQ(64u, chunker.next(data.data(), 64));
+    // без границ по содержимому фрагмент режется на максимальном размере
+    EXPECT_EQ(1024u, chunker.next(data.data(), data.size()));
+
+    EXPECT_THROW(Chunker(64, 100, 1024), std::invalid_argument);
+    EXPECT_THROW(Chunker(256, 256, 1024), std::invalid_argument);
+    EXPECT_THROW(Chunker(64, 2048, 1024), std::invalid_argument);
+    if (sizeof(std::size_t) > sizeof(std::uint32_t))
+    {
+        const std::size_t tooLarge = std::size_t(std::numeric_limits<std::uint32_t>::max()) + 1;
+        EXPECT_THROW(Chunker(64, 256, tooLarge), std::invalid_argument);
+    }
+}
+
+TEST_F(ChunkStoreFixture, PutGet_Success)
+{
+    ChunkStore store(directory);
+    const std::string data = randomData(200000, 1);
+    const ChunkStore::Recipe recipe = store.put(data);
+    ASSERT_GT(recipe.size(), 1u);
+    EXPECT_EQ(data, store.get(recipe));
+    for (const hash::Hash& key : recipe)
+    {
+        EXPECT_EQ(ChunkStore::KEY_SIZE, key.size());
+        EXPECT_TRUE(store.contains(key));
+    }
+
+    EXPECT_TRUE(store.put(std::string()).empty());
+    EXPECT_EQ("", store.get(ChunkStore::Recipe()));
+}
+
+TEST_F(ChunkStoreFixture, ChunkKeyIsSha256_Success)
+{
+    ChunkStore store(directory);
+    hash::HashStream stream;
+    stream << "000";
+    EXPECT_EQ(stream.getHash(), store.putChunk("000", 3));
+}
+
+TEST_F(ChunkStoreFixture, Duplicate_NotWritten)
+{
+    ChunkStore store(directory);
+    const std::string data = randomData(100000, 2);
+    const ChunkStore::Recipe first = store.put(data);
+    const ChunkStore::Stats before = store.stats();
+    EXPECT_EQ(data.size(), before.storedBytes);
+
+    const ChunkStore::Recipe second = store.put(data);
+    const ChunkStore::Stats after = store.stats();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(before.chunks, after.chunks);
+    EXPECT_EQ(before.storedBytes, after.storedBytes);
+    EXPECT_EQ(2 * data.size(), after.putBytes);
+    EXPECT_EQ(data.size(), after.writtenBytes);
+}
+
+TEST_F(ChunkStoreFixture, NearDuplicate_StoresOnlyChanges)
+{
+    ChunkStore store(directory);
+    const std::string original = randomData(1 << 20, 3);
+    std::string edited = original;
+    edited.insert(edited.size() / 2, "inserted in the middle");
+
+    store.put(original);
+    const ChunkStore::Recipe recipe = store.put(edited);
+    const ChunkStore::Stats stats = store.stats();
+    EXPECT_EQ(edited, store.get(recipe));
+    // изменение задевает один-два фрагмента со средним размером 8 КиБ
+    EXPECT_LT(stats.storedBytes - original.size(), 3 * 65536u);
+}
+
+TEST_F(ChunkStoreFixture, PutStream_SameAsBuffer)
+{
+    ChunkStore store(directory);
+    const std::string data = randomData(600000, 4);
+    std::istringstream input(data);
+    EXPECT_EQ(store.put(data), store.put(input));
+}
+
+TEST_F(ChunkStoreFixture, Reopen_Success)
+{
+    const std::string data = randomData(300000, 5);
+    ChunkStore::Recipe recipe;
+    {
+        ChunkStore store(directory);
+        recipe = store.put(data);
+        store.flush();
+    }
+    ChunkStore store(directory);
+    EXPECT_EQ(data, store.get(recipe));
+    EXPECT_EQ(recipe.size(), store.stats().chunks);
+}
+
+TEST_F(ChunkStoreFixture, IndexGrowth_Success)
+{
+    std::vector<hash::Hash> keys;
+    {
+        ChunkStore store(directory);
+        for (int i = 0; i < 5000; ++i)
+        {
+            const std::string chunk = "chunk " + std::to_string(i);
+            keys.push_back(store.putChunk(chunk.data(), chunk.size()));
+        }
+        EXPECT_EQ(5000u, store.stats().chunks);
+    }
+    ChunkStore store(directory);
+    std::string chunk;
+    for (int i = 0; i < 5000; ++i)
+    {
+        ASSERT_TRUE(store.getChunk(keys[static_cast<size_t>(i)], chunk));
+        EXPECT_EQ("chunk " + std::to_string(i), chunk);
+    }
+}
+
+TEST_F(ChunkStoreFixture, Missing_Fail)
+{
+    ChunkStore store(directory);
+    hash::Hash unknown(ChunkStore::KEY_SIZE);
+    std::string chunk;
+    EXPECT_FALSE(store.contains(unknown));
+    EXPECT_FALSE(store.getChunk(unknown, chunk));
+    EXPECT_FALSE(store.contains(hash::Hash()));
+    EXPECT_THROW(store.get({unknown}), std::out_of_range);
+}
+
+TEST_F(ChunkStoreFixture, ChunkTooLarge_Fail)
+{
+    if (sizeof(std::size_t) <= sizeof(std::uint32_t))
+        GTEST_SKIP() << "size_t cannot exceed the index size field";
+    ChunkStore store(directory);
+    // размер проверяется до чтения данных
+    const char data = 0;
+    const std::size_t tooLarge = std::size_t(std::numeric_limits<std::uint32_t>::max()) + 1;
+    EXPECT_THROW(store.putChunk(&data, tooLarge), std::length_error);
+    EXPECT_EQ(0u, store.stats().chunks);
+}
+
+TEST_F(ChunkStoreFixture, RehashFailure_RemovesTemporary)
+{
+    ChunkStore store(directory);
+    for (int i = 0; i < 100; ++i)
+        store.putChunk(std::to_string(i).data(), std::to_string(i).size());
+    // отображение индекса остаётся живым, а rename поверх каталога завершится ошибкой
+    std::filesystem::remove(directory / "index.dat");
+    std::filesystem::create_directories(directory / "index.dat" / "blocker");
+    bool failed = false;
+    for (int i = 100; i < 1000 && !failed; ++i)
+    {
+        const std::string chunk = std::to_string(i);
+        try
+        {
+            store.putChunk(chunk.data(), chunk.size());
+        }
+        catch (const std::filesystem::filesystem_error&)
+        {
+            failed = true;
+        }
+    }
+    EXPECT_TRUE(failed);
+    EXPECT_FALSE(std::filesystem::exists(directory / "index.dat.tmp"));
+    std::string chunk;
+    EXPECT_TRUE(store.getChunk(store.putChunk("42", 2), chunk));
+    EXPECT_EQ("42", chunk);
+}
+
+TEST_F(ChunkStoreFixture, CorruptedIndex_Fail)
+{
+    {
+        ChunkStore store(directory);
+    }
+    std::filesystem::resize_file(directory / "index.dat", 100);
+    EXPECT_THROW(ChunkStore store(directory), std::runtime_error);
+}
+
+TEST_F(ChunkStoreFixture, Concurrent_Success)
+{
+    ChunkStore store(directory);
+    const std::string shared = randomData(200000, 6);
+    std::vector<std::thread> threads;
+    std::vector<std::string> results(8);
+    for (unsigned t = 0; t < results.size(); ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                const std::string own = randomData(50000, 100 + t);
+                const ChunkStore::Recipe sharedRecipe = store.put(shared);
+                const ChunkStore::Recipe ownRecipe = store.put(own);
+                results[t] = store.get(sharedRecipe) == shared && store.get(ownRecipe) == own
+                                 ? "ok"
+                                 : "mismatch";
+            });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    for (const std::string& result : results)
+        EXPECT_EQ("ok", result);
+    EXPECT_EQ(shared.size() + 8 * 50000u, store.stats().storedBytes);
+}
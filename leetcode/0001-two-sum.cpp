@@ -8,6 +8,8 @@
     Space: O(n)
 */
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -20,7 +22,7 @@ public:
     {
         map<int, int> valueToIndexMap;
 
-        for (int i = 0; i < nums.size(); i++)
+        for (int i = 0; i < static_cast<int>(nums.size()); i++)
         {
             int pair = target - nums.at(i);
             if (valueToIndexMap.find(pair) != valueToIndexMap.end())
@@ -30,4 +32,64 @@ public:
 
         return {};
     }
-};
\ No newline at end of file
+};
+
+/*
+    Same idea with an open-addressing table instead of a tree:
+    linear probing over a power-of-two array at most half full, one lookup per num
+
+    Time: O(n) expected
+    Space: O(n)
+*/
+
+class OptimizedSolution
+{
+public:
+    vector<int> twoSum(const vector<int>& nums, int target)
+    {
+        size_t capacity = 2;
+        int shift = 63;
+        while (capacity < nums.size() * 2)
+        {
+            capacity *= 2;
+            shift--;
+        }
+        const size_t mask = capacity - 1;
+        vector<Slot> slots(capacity);
+
+        for (int i = 0; i < static_cast<int>(nums.size()); i++)
+        {
+            const int pair = target - nums[i];
+            for (size_t slot = hash(pair, shift); slots[slot].index >= 0;
+                 slot = (slot + 1) & mask)
+            {
+                if (slots[slot].value == pair)
+                    return {i, slots[slot].index};
+            }
+
+            size_t slot = hash(nums[i], shift);
+            while (slots[slot].index >= 0 && slots[slot].value != nums[i])
+                slot = (slot + 1) & mask;
+            if (slots[slot].index < 0)
+                slots[slot] = Slot{nums[i], i};
+        }
+
+        return {};
+    }
+
+private:
+    struct Slot
+    {
+        int value = 0;
+        int index = -1;
+    };
+
+    // fibonacci hashing: the top bits of the product depend on every bit of the key,
+    // so keys differing only in high bits still spread across the table
+    static size_t hash(int value, int shift)
+    {
+        return static_cast<size_t>(
+            (static_cast<uint64_t>(static_cast<uint32_t>(value)) * 0x9E3779B97F4A7C15ull) >>
+            shift);
+    }
+};
@@ -0,0 +1,45 @@
+#include "0001-two-sum.cpp"
+#include "bench.hpp"
+#include <benchmark/benchmark.h>
+
+// пара в конце массива: оба решения просматривают весь вход
+static vector<int> input(size_t size, int& target)
+{
+    vector<int> nums = bench::randomInts(size, 0, 1 << 29);
+    nums[size - 2] = (1 << 29) + 1;
+    nums[size - 1] = (1 << 29) + 2;
+    target = nums[size - 2] + nums[size - 1];
+    return nums;
+}
+
+template <typename S>
+static void BM_TwoSum(benchmark::State& state)
+{
+    int target = 0;
+    vector<int> nums = input(static_cast<size_t>(state.range(0)), target);
+    const vector<int> expected = {static_cast<int>(nums.size()) - 1,
+                                  static_cast<int>(nums.size()) - 2};
+    if (S().twoSum(nums, target) != expected)
+        state.SkipWithError("wrong answer");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(S().twoSum(nums, target));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TwoSum<Solution>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_TwoSum<OptimizedSolution>)->Range(1 << 10, 1 << 20);
+
+// ключи различаются только старшими битами, пары нет: проверка хеша на младших битах
+template <typename S>
+static void BM_TwoSumHighBits(benchmark::State& state)
+{
+    vector<int> nums(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < nums.size(); i++)
+        nums[i] = static_cast<int>(static_cast<unsigned>(i) << 15);
+    if (!S().twoSum(nums, -1).empty())
+        state.SkipWithError("wrong answer");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(S().twoSum(nums, -1));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TwoSumHighBits<Solution>)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_TwoSumHighBits<OptimizedSolution>)->Range(1 << 10, 1 << 16);
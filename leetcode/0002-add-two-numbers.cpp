@@ -1,3 +1,8 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 using namespace std;
 
 // Definition for singly-linked list.
@@ -46,4 +51,192 @@ public:
 
         return begin.next;
     }
-};
\ No newline at end of file
+};
+
+/*
+    Nodes are carved out of blocks and released all at once: the memory is reused after
+    release() and freed with the arena, so repeated sums stop allocating altogether
+
+    Time: O(n)
+    Space: O(n), freed in bulk
+*/
+
+class NodeArena
+{
+public:
+    explicit NodeArena(size_t blockSize = 4096) : blockSize(blockSize)
+    {
+    }
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    ListNode* make(int val, ListNode* next = nullptr)
+    {
+        if (used == blockSize || blocks.empty())
+            nextBlock();
+        ListNode* node = &blocks[current][used++];
+        node->val = val;
+        node->next = next;
+        return node;
+    }
+    // all nodes made by the arena become invalid, blocks are kept for reuse
+    void release()
+    {
+        current = 0;
+        used = 0;
+    }
+    size_t allocations() const
+    {
+        return blocks.size();
+    }
+
+private:
+    void nextBlock()
+    {
+        if (!blocks.empty())
+            current++;
+        if (current == blocks.size())
+            blocks.push_back(make_unique<ListNode[]>(blockSize));
+        used = 0;
+    }
+
+private:
+    size_t blockSize;
+    size_t current = 0;
+    size_t used = 0;
+    vector<unique_ptr<ListNode[]>> blocks;
+};
+
+class ArenaSolution
+{
+public:
+    explicit ArenaSolution(NodeArena& arena) : arena(arena)
+    {
+    }
+
+    ListNode* addTwoNumbers(const ListNode* l1, const ListNode* l2)
+    {
+        ListNode begin = ListNode();
+        ListNode* end = &begin;
+        int extra = 0;
+
+        while (l1 || l2 || extra)
+        {
+            int value = extra;
+            if (l1)
+            {
+                value += l1->val;
+                l1 = l1->next;
+            }
+            if (l2)
+            {
+                value += l2->val;
+                l2 = l2->next;
+            }
+
+            extra = value / 10;
+            end->next = arena.make(value % 10);
+            end = end->next;
+        }
+
+        return begin.next;
+    }
+
+private:
+    NodeArena& arena;
+};
+
+/*
+    Contiguous representation: 18 decimal digits per 64-bit limb, least significant first,
+    the sum of two limbs and a carry stays below 2^64; leading zeros are not kept
+
+    Time: O(n / 18)
+    Space: O(n / 18)
+*/
+
+class LimbNumber
+{
+public:
+    static constexpr uint64_t BASE = 1000000000000000000ull;
+    static constexpr int DIGITS = 18;
+
+    LimbNumber() = default;
+
+    static LimbNumber fromList(const ListNode* list)
+    {
+        LimbNumber result;
+        uint64_t limb = 0, scale = 1;
+        int digits = 0;
+        for (; list; list = list->next)
+        {
+            limb += static_cast<uint64_t>(list->val) * scale;
+            scale *= 10;
+            if (++digits == DIGITS)
+            {
+                result.limbs.push_back(limb);
+                limb = 0;
+                scale = 1;
+                digits = 0;
+            }
+        }
+        if (digits > 0 || result.limbs.empty())
+            result.limbs.push_back(limb);
+        result.trim();
+        return result;
+    }
+
+    ListNode* toList(NodeArena& arena) const
+    {
+        ListNode begin = ListNode();
+        ListNode* end = &begin;
+        for (size_t i = 0; i < limbs.size(); i++)
+        {
+            uint64_t limb = limbs[i];
+            const bool last = i + 1 == limbs.size();
+            for (int digit = 0; digit < DIGITS && (!last || limb || digit == 0); digit++)
+            {
+                end->next = arena.make(static_cast<int>(limb % 10));
+                end = end->next;
+                limb /= 10;
+            }
+        }
+        return begin.next;
+    }
+
+    friend LimbNumber operator+(const LimbNumber& lhs, const LimbNumber& rhs)
+    {
+        const LimbNumber& longer = lhs.limbs.size() >= rhs.limbs.size() ? lhs : rhs;
+        const LimbNumber& shorter = &longer == &lhs ? rhs : lhs;
+
+        LimbNumber result;
+        result.limbs.reserve(longer.limbs.size() + 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < longer.limbs.size(); i++)
+        {
+            uint64_t sum = longer.limbs[i] + carry;
+            if (i < shorter.limbs.size())
+                sum += shorter.limbs[i];
+            carry = sum >= BASE ? 1 : 0;
+            result.limbs.push_back(sum - carry * BASE);
+        }
+        if (carry)
+            result.limbs.push_back(carry);
+        return result;
+    }
+
+    size_t size() const
+    {
+        return limbs.size();
+    }
+
+private:
+    // leading zero limbs from zero digits at the end of the list
+    void trim()
+    {
+        while (limbs.size() > 1 && limbs.back() == 0)
+            limbs.pop_back();
+    }
+
+private:
+    vector<uint64_t> limbs;
+};
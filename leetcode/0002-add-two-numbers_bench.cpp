@@ -0,0 +1,152 @@
+#include "0002-add-two-numbers.cpp"
+#include "bench.hpp"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+// подсчёт выделений памяти во всей программе
+static std::atomic<size_t> allocationCount{0};
+
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+// GCC не знает, что замещённый operator new выделяет память через malloc
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+#pragma GCC diagnostic pop
+
+// число без ведущих нулей, как во входных данных задачи
+static ListNode* makeList(NodeArena& arena, size_t digits)
+{
+    vector<int> values = bench::randomInts(digits, 0, 9);
+    values.back() = bench::randomInts(1, 1, 9).front();
+    ListNode begin;
+    ListNode* end = &begin;
+    for (int value : values)
+    {
+        end->next = arena.make(value);
+        end = end->next;
+    }
+    return begin.next;
+}
+
+static bool equal(const ListNode* lhs, const ListNode* rhs)
+{
+    for (; lhs && rhs; lhs = lhs->next, rhs = rhs->next)
+    {
+        if (lhs->val != rhs->val)
+            return false;
+    }
+    return !lhs && !rhs;
+}
+
+static void deleteList(ListNode* list)
+{
+    while (list)
+        delete std::exchange(list, list->next);
+}
+
+static void setCounters(benchmark::State& state, size_t allocations)
+{
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations),
+                                                  benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_AddTwoNumbersNew(benchmark::State& state)
+{
+    NodeArena operands;
+    ListNode* l1 = makeList(operands, static_cast<size_t>(state.range(0)));
+    ListNode* l2 = makeList(operands, static_cast<size_t>(state.range(0)));
+    size_t allocations = 0;
+    for (auto _ : state)
+    {
+        const size_t before = allocationCount.load(std::memory_order_relaxed);
+        ListNode* sum = Solution().addTwoNumbers(l1, l2);
+        allocations += allocationCount.load(std::memory_order_relaxed) - before;
+        benchmark::DoNotOptimize(sum);
+        state.PauseTiming();
+        deleteList(sum);
+        state.ResumeTiming();
+    }
+    setCounters(state, allocations);
+}
+BENCHMARK(BM_AddTwoNumbersNew)->Range(1 << 10, 1 << 20);
+
+static void BM_AddTwoNumbersArena(benchmark::State& state)
+{
+    NodeArena operands;
+    ListNode* l1 = makeList(operands, static_cast<size_t>(state.range(0)));
+    ListNode* l2 = makeList(operands, static_cast<size_t>(state.range(0)));
+    NodeArena arena;
+    size_t allocations = 0;
+    for (auto _ : state)
+    {
+        const size_t before = allocationCount.load(std::memory_order_relaxed);
+        benchmark::DoNotOptimize(ArenaSolution(arena).addTwoNumbers(l1, l2));
+        arena.release();
+        allocations += allocationCount.load(std::memory_order_relaxed) - before;
+    }
+    setCounters(state, allocations);
+}
+BENCHMARK(BM_AddTwoNumbersArena)->Range(1 << 10, 1 << 20);
+
+static void BM_AddLimbNumbers(benchmark::State& state)
+{
+    NodeArena operands;
+    ListNode* l1 = makeList(operands, static_cast<size_t>(state.range(0)));
+    ListNode* l2 = makeList(operands, static_cast<size_t>(state.range(0)));
+    const LimbNumber n1 = LimbNumber::fromList(l1);
+    const LimbNumber n2 = LimbNumber::fromList(l2);
+
+    NodeArena check;
+    if (!equal((n1 + n2).toList(check), ArenaSolution(check).addTwoNumbers(l1, l2)))
+        state.SkipWithError("wrong answer");
+
+    size_t allocations = 0;
+    for (auto _ : state)
+    {
+        const size_t before = allocationCount.load(std::memory_order_relaxed);
+        benchmark::DoNotOptimize(n1 + n2);
+        allocations += allocationCount.load(std::memory_order_relaxed) - before;
+    }
+    setCounters(state, allocations);
+}
+BENCHMARK(BM_AddLimbNumbers)->Range(1 << 10, 1 << 20);
+
+static void BM_AddLimbNumbersFromList(benchmark::State& state)
+{
+    NodeArena operands;
+    ListNode* l1 = makeList(operands, static_cast<size_t>(state.range(0)));
+    ListNode* l2 = makeList(operands, static_cast<size_t>(state.range(0)));
+    NodeArena arena;
+    size_t allocations = 0;
+    for (auto _ : state)
+    {
+        const size_t before = allocationCount.load(std::memory_order_relaxed);
+        const LimbNumber sum = LimbNumber::fromList(l1) + LimbNumber::fromList(l2);
+        benchmark::DoNotOptimize(sum.toList(arena));
+        arena.release();
+        allocations += allocationCount.load(std::memory_order_relaxed) - before;
+    }
+    setCounters(state, allocations);
+}
+BENCHMARK(BM_AddLimbNumbersFromList)->Range(1 << 10, 1 << 20);
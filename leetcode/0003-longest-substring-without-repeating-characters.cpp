@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <array>
 #include <set>
 #include <string>
 
@@ -8,7 +10,7 @@ class Solution
 public:
     int lengthOfLongestSubstring(string s)
     {
-        int leftInclusive = 0, rightExclusive = 0, maxSize = 0;
+        size_t leftInclusive = 0, rightExclusive = 0, maxSize = 0;
         set<char> charSet;
 
         while (rightExclusive < s.size())
@@ -26,6 +28,35 @@ public:
                 maxSize = charSet.size();
         }
 
+        return static_cast<int>(maxSize);
+    }
+};
+
+/*
+    Sliding window over last seen positions instead of a set:
+    on repeat jump the left edge past the previous occurrence
+
+    Time: O(n)
+    Space: O(1), 256 entries for the byte alphabet
+*/
+
+class OptimizedSolution
+{
+public:
+    int lengthOfLongestSubstring(const string& s)
+    {
+        array<int, 256> lastSeen;
+        lastSeen.fill(-1);
+        int leftInclusive = 0, maxSize = 0;
+
+        for (int right = 0; right < static_cast<int>(s.size()); right++)
+        {
+            const unsigned char symbol = static_cast<unsigned char>(s[right]);
+            leftInclusive = max(leftInclusive, lastSeen[symbol] + 1);
+            lastSeen[symbol] = right;
+            maxSize = max(maxSize, right - leftInclusive + 1);
+        }
+
         return maxSize;
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,16 @@
+#include "0003-longest-substring-without-repeating-characters.cpp"
+#include "bench.hpp"
+#include <benchmark/benchmark.h>
+
+template <typename S>
+static void BM_LengthOfLongestSubstring(benchmark::State& state)
+{
+    const string s = bench::randomString(static_cast<size_t>(state.range(0)), ' ', '~');
+    if (S().lengthOfLongestSubstring(s) != Solution().lengthOfLongestSubstring(s))
+        state.SkipWithError("wrong answer");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(S().lengthOfLongestSubstring(s));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LengthOfLongestSubstring<Solution>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_LengthOfLongestSubstring<OptimizedSolution>)->Range(1 << 10, 1 << 20);
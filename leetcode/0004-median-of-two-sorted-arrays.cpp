@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 using namespace std;
@@ -18,4 +19,49 @@ public:
         return nums.size() % 2 == 1 ? nums[nums.size() / 2]
                                     : (nums[nums.size() / 2 - 1] + nums[nums.size() / 2]) / 2.;
     }
-};
\ No newline at end of file
+};
+
+/*
+    Binary search for a partition of the shorter array, so that
+    left halves of both arrays together hold the lower half of all nums
+
+    Time: O(log min(m, n))
+    Space: O(1)
+*/
+
+class OptimizedSolution
+{
+public:
+    double findMedianSortedArrays(const vector<int>& nums1, const vector<int>& nums2)
+    {
+        if (nums1.size() > nums2.size())
+            return findMedianSortedArrays(nums2, nums1);
+
+        const int m = static_cast<int>(nums1.size());
+        const int n = static_cast<int>(nums2.size());
+        const int half = (m + n + 1) / 2;
+        int low = 0, high = m;
+
+        while (low <= high)
+        {
+            const int cut1 = low + (high - low) / 2;
+            const int cut2 = half - cut1;
+
+            const int left1 = cut1 > 0 ? nums1[cut1 - 1] : numeric_limits<int>::min();
+            const int right1 = cut1 < m ? nums1[cut1] : numeric_limits<int>::max();
+            const int left2 = cut2 > 0 ? nums2[cut2 - 1] : numeric_limits<int>::min();
+            const int right2 = cut2 < n ? nums2[cut2] : numeric_limits<int>::max();
+
+            if (left1 > right2)
+                high = cut1 - 1;
+            else if (left2 > right1)
+                low = cut1 + 1;
+            else if ((m + n) % 2 == 1)
+                return max(left1, left2);
+            else
+                return (static_cast<double>(max(left1, left2)) + min(right1, right2)) / 2.;
+        }
+
+        return 0.;
+    }
+};
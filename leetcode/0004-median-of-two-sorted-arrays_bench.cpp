@@ -0,0 +1,19 @@
+#include "0004-median-of-two-sorted-arrays.cpp"
+#include "bench.hpp"
+#include <benchmark/benchmark.h>
+
+template <typename S>
+static void BM_FindMedianSortedArrays(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    const vector<int> nums1 = bench::randomSortedInts(size, -1000000, 1000000);
+    const vector<int> nums2 = bench::randomSortedInts(size / 3 + 1, -1000000, 1000000);
+    if (S().findMedianSortedArrays(nums1, nums2) !=
+        Solution().findMedianSortedArrays(nums1, nums2))
+        state.SkipWithError("wrong answer");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(S().findMedianSortedArrays(nums1, nums2));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindMedianSortedArrays<Solution>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_FindMedianSortedArrays<OptimizedSolution>)->Range(1 << 10, 1 << 20);
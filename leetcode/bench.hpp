@@ -0,0 +1,50 @@
+#ifndef LEETCODE_BENCH_HPP
+#define LEETCODE_BENCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Генераторы входных данных для сравнения решений
+ * @note Зерно фиксировано, чтобы все варианты решения получали одинаковые данные
+ */
+namespace bench
+{
+
+inline std::mt19937& generator()
+{
+    static std::mt19937 instance(42);
+    return instance;
+}
+
+inline std::vector<int> randomInts(std::size_t size, int min, int max)
+{
+    std::uniform_int_distribution<int> distribution(min, max);
+    std::vector<int> result(size);
+    for (int& value : result)
+        value = distribution(generator());
+    return result;
+}
+
+inline std::vector<int> randomSortedInts(std::size_t size, int min, int max)
+{
+    std::vector<int> result = randomInts(size, min, max);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+inline std::string randomString(std::size_t size, char first, char last)
+{
+    std::uniform_int_distribution<int> distribution(first, last);
+    std::string result(size, first);
+    for (char& symbol : result)
+        symbol = static_cast<char>(distribution(generator()));
+    return result;
+}
+
+} // namespace bench
+
+#endif // LEETCODE_BENCH_HPP
@@ -1,5 +1,5 @@
 BUILD_DIR='build'
-BUILD_TYPE='Debug'
+BUILD_TYPE=${BUILD_TYPE:-Debug}
 
 clean()
 {
@@ -9,7 +9,7 @@ clean()
 build()
 {
     conan install . --build=missing --output-folder=$BUILD_DIR --settings=build_type=$BUILD_TYPE
-    cmake -B $BUILD_DIR -DCMAKE_BUILD_TYPE=$BUILD_TYPE
+    cmake -B $BUILD_DIR -DCMAKE_BUILD_TYPE=$BUILD_TYPE "$@"
     cmake --build $BUILD_DIR -j $(nproc)
 }
 
@@ -18,6 +18,27 @@ test()
     ctest --test-dir $BUILD_DIR/feature --output-on-failure
 }
 
+bench()
+{
+    for benchmark in $(find $BUILD_DIR -type f -executable -name '*_bench' | sort)
+    do
+        $benchmark "$@" || return 1
+    done
+}
+
+pgo()
+{
+    local profile_dir=$(realpath -m $BUILD_DIR/pgo)
+    rm -rf $profile_dir
+    BUILD_TYPE=Release build -DPGO_MODE=GENERATE -DPGO_DIR=$profile_dir "$@" &&
+        bench --benchmark_min_time=0.05s > /dev/null &&
+        BUILD_TYPE=Release build -DPGO_MODE=USE -DPGO_DIR=$profile_dir "$@"
+    local status=$?
+    # PGO_MODE хранится в кэше CMake: следующая обычная сборка не должна его унаследовать
+    cmake -B $BUILD_DIR -UPGO_MODE -UPGO_DIR > /dev/null
+    return $status
+}
+
 container()
 {
 	local image_name='dev'